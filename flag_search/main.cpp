@@ -303,7 +303,7 @@ int main(int argc, char *argv[]) {
 	RandomFlag::MaxMin latitude_deg{global_coordinate_south_west.latitude_deg, global_coordinate_north_east.latitude_deg};
 	RandomFlag::MaxMin longitude_deg{global_coordinate_south_west.longitude_deg, global_coordinate_north_east.longitude_deg};
 	RandomFlag flag{latitude_deg, longitude_deg};
-	Polygon search_area;
+	SmallPolygon<4> search_area;
 	search_area.push_back({latitude_deg.get_min(), longitude_deg.get_min()});
 	search_area.push_back({latitude_deg.get_min(), longitude_deg.get_max()});
 	search_area.push_back({latitude_deg.get_max(), longitude_deg.get_max()});
@@ -311,7 +311,7 @@ int main(int argc, char *argv[]) {
 	*/
 
 	geometry::CoordinateTransformation::GlobalCoordinate global_coordinate;
-	Polygon search_area;
+	SmallPolygon<4> search_area;
 	/*
 	global_coordinate = coordinate_transformation.global_from_local({0, 0});
 	search_area.push_back({global_coordinate.latitude_deg, global_coordinate.longitude_deg});
@@ -382,7 +382,7 @@ int main(int argc, char *argv[]) {
 	logger << debug << "The flag is in:\n" << static_cast<string>(flag) << endl;
 
 	logger.write(debug, "Search area:");
-	for (auto v : search_area.get_vertices()) {
+	for (auto v : search_area) {
 		logger << debug << "    " << v << endl;
 	}
 
@@ -390,7 +390,7 @@ int main(int argc, char *argv[]) {
 	geometry::CoordinateTransformation::GlobalCoordinate base{coordinate_transformation.global_from_local({0, 0})};
 	geometry::CoordinateTransformation::GlobalCoordinate separation{coordinate_transformation.global_from_local({SEPARATION, 0})};
 	logger << debug << "Separation: " << (separation.latitude_deg - base.latitude_deg) << endl;
-	ParallelSweep mission_helper{search_area, separation.latitude_deg - base.latitude_deg};
+	ParallelSweep mission_helper{search_area.to_polygon(), separation.latitude_deg - base.latitude_deg};
 
 	// Setting the systems counter //
 	PercentageCheck enough_systems{static_cast<float>(expected_systems), PERCENTAGE_DRONES_REQUIRED};
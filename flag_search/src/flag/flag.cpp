@@ -143,24 +143,8 @@ RandomFlagPoly::RandomFlagPoly(const bool use_seed) {
         polygon.push_back(vertex);
     }
 
-    Point max{polygon[0]};
-    Point min{polygon[0]};
-
-    size_t poly_size{polygon.size()};
-
-    for (size_t i = 0; i < poly_size; ++i) {
-        if (min.x > polygon[i].x)
-            min.x = polygon[i].x;
-
-        if (min.y > polygon[i].y)
-            min.y = polygon[i].y;
-
-        if (max.x < polygon[i].x)
-            max.x = polygon[i].x;
-
-        if (max.y < polygon[i].y)
-            max.y = polygon[i].y;
-    }
+    const Point max{default_polygon_max};
+    const Point min{default_polygon_min};
 
     RandomFlag::MaxMin maxmin_latitude_deg{max.x, min.x};
     RandomFlag::MaxMin maxmin_longitude_deg{max.y, min.y};
@@ -189,24 +173,8 @@ RandomFlagPoly::RandomFlagPoly(const bool use_seed) {
  * Otherwise the default seed will be used.
  */
 RandomFlagPoly::RandomFlagPoly(const Polygon polygon, const bool use_seed) {
-    Point max{polygon[0]};
-    Point min{polygon[0]};
-
-    size_t poly_size{polygon.size()};
-
-    for (size_t i = 0; i < poly_size; ++i) {
-        if (min.x > polygon[i].x)
-            min.x = polygon[i].x;
-
-        if (min.y > polygon[i].y)
-            min.y = polygon[i].y;
-
-        if (max.x < polygon[i].x)
-            max.x = polygon[i].x;
-
-        if (max.y < polygon[i].y)
-            max.y = polygon[i].y;
-    }
+    const Point max{polygon.find_max_corner()};
+    const Point min{polygon.find_min_corner()};
 
     RandomFlag::MaxMin maxmin_latitude_deg{max.x, min.x};
     RandomFlag::MaxMin maxmin_longitude_deg{max.y, min.y};
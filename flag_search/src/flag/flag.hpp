@@ -89,8 +89,18 @@ class RandomFlagPoly : public Flag {
         RandomFlagPoly(const bool use_seed=true);
         RandomFlagPoly(const Polygon polygon, const bool use_seed=true);
 
-        inline static const std::array default_polygon_vertices{Point{-10, -10},
-                                                                Point{-10, 10},
-                                                                Point{10, 10},
-                                                                Point{10, -10}};
-};
\ No newline at end of file
+        static constexpr std::array default_polygon_vertices{Point{-10, -10},
+                                                             Point{-10, 10},
+                                                             Point{10, 10},
+                                                             Point{10, -10}};
+
+        static constexpr double default_polygon_square{poly_private::count_square(default_polygon_vertices)};
+        static constexpr Point default_polygon_min{poly_private::find_min_corner(default_polygon_vertices)};
+        static constexpr Point default_polygon_max{poly_private::find_max_corner(default_polygon_vertices)};
+        static constexpr Point default_polygon_center{poly_private::find_center(default_polygon_vertices)};
+};
+
+static_assert(RandomFlagPoly::default_polygon_square == 400);
+static_assert(RandomFlagPoly::default_polygon_min == Point(-10, -10));
+static_assert(RandomFlagPoly::default_polygon_max == Point(10, 10));
+static_assert(RandomFlagPoly::default_polygon_center == Point(0, 0));
\ No newline at end of file
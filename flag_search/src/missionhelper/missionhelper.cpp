@@ -20,20 +20,75 @@
 
 #include "missionhelper.hpp"
 
-PolySplitMission::PolySplitMission(Polygon area) {
-    this->area = area;
-}
+PartitionPlan::PartitionPlan(const Polygon &area, const unsigned int number_of_systems,
+                             const AreaPartitioner &partitioner) {
+    if (number_of_systems == 1) {
+        polygons.push_back(area);
+        return;
+    }
 
-void PolySplitMission::get_polygon_of_interest(const unsigned int system_id, const unsigned int number_of_systems, Polygon *polygon_of_interest) const {
+    // The tolerances of split are absolute, set for coordinates of the
+    // order of units. In degrees a whole cell would fall below them, so
+    // the partitioners work on the vertices in millionths of a degree
     const double precision{1E6};
-    Polygon helper = area;
-    for (size_t i = 0; i < helper.size(); ++i) {
-        helper[i] *= precision;
-        helper[i].x = round(helper[i].x);
-        helper[i].y = round(helper[i].y);
+    Points scaled_vertices;
+    scaled_vertices.reserve(area.size());
+    for (const Point &vertex : area.get_vertices()) {
+        scaled_vertices.push_back(Point{round(vertex.x * precision), round(vertex.y * precision)});
     }
+    Polygon rounded_area{std::move(scaled_vertices)};
 
-    double partial_area{helper.count_square() / static_cast<double>(number_of_systems)};
+    // The rounding may repeat or align vertices, or make edges cross, which
+    // is fixed or reported here instead of failing inside the split search
+    try {
+        rounded_area = rounded_area.normalize();
+    } catch (const Polygon::NotEnoughPointsException &) {
+        throw CannotMakeMission{"The required area is zero or less"};
+    } catch (const Polygon::SelfIntersectionException &e) {
+        throw CannotMakeMission(std::string{"The required area is not a simple polygon. "} + e.what());
+    }
+
+    std::vector<Polygon> scaled_polygons;
+    try {
+        scaled_polygons = partitioner.partition(rounded_area, number_of_systems);
+    } catch (const Polygon::CannotSplitException &e) {
+        throw CannotMakeMission(std::string{"Cannot split the required area. "} + e.what());
+    }
+
+    polygons.reserve(scaled_polygons.size());
+    for (const Polygon &polygon : scaled_polygons) {
+        Points vertices;
+        vertices.reserve(polygon.size());
+        for (const Point &vertex : polygon.get_vertices()) {
+            vertices.push_back(vertex / precision);
+        }
+        polygons.emplace_back(std::move(vertices));
+    }
+}
+
+const Polygon &PartitionPlan::get_polygon(const unsigned int system_id) const {
+    return polygons.at(system_id - 1);
+}
+
+unsigned int PartitionPlan::get_number_of_systems() const {
+    return polygons.size();
+}
+
+PolySplitMission::PolySplitMission(Polygon area, std::shared_ptr<const AreaPartitioner> partitioner,
+                                   const Polygon::Simplification &simplification) {
+    if (simplification.method == Polygon::Simplification::Method::None)
+        this->area = std::move(area);
+    else
+        this->area = area.simplify(simplification);
+
+    if (partitioner)
+        this->partitioner = partitioner;
+    else
+        this->partitioner = std::make_shared<SequentialPartitioner>();
+}
+
+void PolySplitMission::get_polygon_of_interest(const unsigned int system_id, const unsigned int number_of_systems, Polygon *polygon_of_interest) const {
+    double partial_area{area.count_square() / static_cast<double>(number_of_systems)};
 
     if (partial_area <= 0) {
         throw CannotMakeMission{"The required area is zero or less"};
@@ -47,44 +102,42 @@ void PolySplitMission::get_polygon_of_interest(const unsigned int system_id, con
         throw CannotMakeMission{"The system ID must be less than or equal to the number of systems"};
     }
 
-    Polygon poly1;
-    Polygon poly2;
-    Polygon *polygon_of_interest_tmp = &poly1;
-    Polygon *discarded_area{&poly2};
-    Segment cut_line;
-
-    const unsigned int n_iterations{(system_id < number_of_systems) ? system_id : (number_of_systems - 1)};
-
-    for (unsigned int i = 0; i < n_iterations; ++i) {
-        try {
-            helper.split(partial_area, poly1, poly2, cut_line);
-        } catch (const Polygon::CannotSplitException &e) {
-            throw CannotMakeMission(std::string{"Cannot split the required area. "} + e.what());
-        }
-
-        if (poly1.count_square() - partial_area < poly2.count_square() - partial_area) {
-            polygon_of_interest_tmp = &poly1;
-            discarded_area = &poly2;
-        } else {
-            polygon_of_interest_tmp = &poly2;
-            discarded_area = &poly1;
-        }
-
-        helper = *discarded_area;
-    }
+    *polygon_of_interest = get_partition_plan(number_of_systems).get_polygon(system_id);
+}
 
-    if (number_of_systems == 1) {
-        *polygon_of_interest_tmp = area;
+const PartitionPlan &PolySplitMission::get_partition_plan(const unsigned int number_of_systems) const {
+    std::promise<PartitionPlan> promise;
+    std::shared_future<PartitionPlan> plan;
+    bool owner{false};
+
+    plans_mut.lock();
+    auto it{plans.find(number_of_systems)};
+    if (it == plans.end()) {
+        plan = promise.get_future().share();
+        plans.emplace(number_of_systems, plan);
+        owner = true;
     } else {
-        if (system_id == number_of_systems) 
-            polygon_of_interest_tmp = discarded_area;
+        plan = it->second;
+    }
+    plans_mut.unlock();
 
-        for (size_t i = 0; i < polygon_of_interest_tmp->size(); ++i) {
-            (*polygon_of_interest_tmp)[i] /= precision;
+    // Only the first thread asking for this number of systems computes
+    // the plan; the rest wait for it
+    if (owner) {
+        try {
+            promise.set_value(PartitionPlan{area, number_of_systems, *partitioner});
+        } catch (...) {
+            promise.set_exception(std::current_exception());
+
+            // The threads already waiting get the error, but a later request
+            // computes the plan again instead of getting the same error
+            plans_mut.lock();
+            plans.erase(number_of_systems);
+            plans_mut.unlock();
         }
     }
 
-    *polygon_of_interest = *polygon_of_interest_tmp;
+    return plan.get();
 }
 
 void GoCenter::new_mission(const unsigned int number_of_systems, std::vector<Mission::MissionItem> &mission, unsigned int system_id) const {
@@ -131,8 +184,9 @@ void SpiralSweepCenter::new_mission(const unsigned int number_of_systems, std::v
     const Point center{polygon_of_interest.find_center()};
 
     std::vector<Segment> segment_vector{};
+    segment_vector.reserve(polygon_of_interest.size());
 
-    for (Point p : polygon_of_interest.get_vertices()) {
+    for (const Point &p : polygon_of_interest.get_vertices()) {
         segment_vector.push_back(Segment{center, p});
     }
 
@@ -201,8 +255,9 @@ void SpiralSweepEdge::new_mission(const unsigned int number_of_systems, std::vec
     const Point center{polygon_of_interest.find_center()};
 
     std::vector<Segment> segment_vector{};
+    segment_vector.reserve(polygon_of_interest.size());
 
-    for (Point p : polygon_of_interest.get_vertices()) {
+    for (const Point &p : polygon_of_interest.get_vertices()) {
         segment_vector.push_back(Segment{p, center});
     }
 
@@ -258,7 +313,7 @@ void ParallelSweep::new_mission(const unsigned int number_of_systems, std::vecto
     const Vector norm{dir.norm().unit() * separation};
     const Line base_line{polygon_of_interest[0], dir};
     std::function<void(const bool, const Vector)> sweep{
-        [base_line, dir, polygon_of_interest, altitude, *this, &mission](const bool first, const Vector norm) {
+        [base_line, dir, &polygon_of_interest, altitude, this, &mission](const bool first, const Vector norm) {
             Line tmp{base_line};
 
             bool cont{true};
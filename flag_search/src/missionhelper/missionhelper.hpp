@@ -19,19 +19,73 @@
 */
 
 #include "../poly/polygon.hpp"
+#include "../poly/partitioner.hpp"
 #include "../../../src/missionhelper/missionhelper.hpp"
 #include <mutex>
+#include <map>
+#include <future>
+#include <memory>
+
+/**
+ * @brief Immutable division of an area into one polygon per system.
+ * It is built once and can be read by several threads at the same time.
+*/
+class PartitionPlan {
+    public:
+        /**
+         * @brief Splits the area into number_of_systems polygons of the same area
+         * using the given partitioner.
+         *
+         * @throws
+         * CannotMakeMission: if the area cannot be split.
+        */
+        PartitionPlan(const Polygon &area, const unsigned int number_of_systems,
+                      const AreaPartitioner &partitioner);
+
+        /**
+         * @brief Returns the polygon assigned to a system, being system_id
+         * a value between 1 and the number of systems.
+        */
+        const Polygon &get_polygon(const unsigned int system_id) const;
+
+        unsigned int get_number_of_systems() const;
+
+    private:
+        std::vector<Polygon> polygons;
+};
 
 struct PolySplitMission : public MissionHelper {
-    PolySplitMission(Polygon area);
+    /**
+     * @param
+     * partitioner: The strategy used to divide the area among the systems.
+     * If null, a SequentialPartitioner is used.
+     * @param
+     * simplification: The simplification applied to the area before it
+     * is divided. By default the area is used as it is.
+    */
+    PolySplitMission(Polygon area, std::shared_ptr<const AreaPartitioner> partitioner=nullptr,
+                     const Polygon::Simplification &simplification={});
 
     protected:
         Polygon area;
+        std::shared_ptr<const AreaPartitioner> partitioner;
 
         /**
          * @brief Gets the area corresponding to a given system using a Polygon object
         */
         virtual void get_polygon_of_interest(const unsigned int system_id, const unsigned int number_of_systems, Polygon *polygon_of_interest) const;
+
+        /**
+         * @brief Returns the partition of the area for a number of systems.
+         * It is computed on the first request and shared by later ones. A
+         * plan that could not be made is not kept, so it is computed again on
+         * the next request.
+        */
+        const PartitionPlan &get_partition_plan(const unsigned int number_of_systems) const;
+
+    private:
+        mutable std::mutex plans_mut;
+        mutable std::map<unsigned int, std::shared_future<PartitionPlan>> plans;
 };
 
 struct GoCenter : public PolySplitMission {
@@ -44,7 +98,9 @@ struct GoCenter : public PolySplitMission {
 };
 
 struct SpiralSweepCenter : public PolySplitMission {
-    SpiralSweepCenter(Polygon area, const double separation) : PolySplitMission(area) {
+    SpiralSweepCenter(Polygon area, const double separation, std::shared_ptr<const AreaPartitioner> partitioner=nullptr,
+                      const Polygon::Simplification &simplification={})
+        : PolySplitMission(std::move(area), partitioner, simplification) {
         this->separation = separation;
     };
 
@@ -60,7 +116,9 @@ struct SpiralSweepCenter : public PolySplitMission {
 };
 
 struct SpiralSweepEdge : public PolySplitMission {
-    SpiralSweepEdge(Polygon area, const double separation) : PolySplitMission(area) {
+    SpiralSweepEdge(Polygon area, const double separation, std::shared_ptr<const AreaPartitioner> partitioner=nullptr,
+                    const Polygon::Simplification &simplification={})
+        : PolySplitMission(std::move(area), partitioner, simplification) {
         this->separation = separation;
     };
 
@@ -76,7 +134,9 @@ struct SpiralSweepEdge : public PolySplitMission {
 };
 
 struct ParallelSweep : public PolySplitMission {
-    ParallelSweep(Polygon area, const double separation) : PolySplitMission(area) {
+    ParallelSweep(Polygon area, const double separation, std::shared_ptr<const AreaPartitioner> partitioner=nullptr,
+                  const Polygon::Simplification &simplification={})
+        : PolySplitMission(std::move(area), partitioner, simplification) {
         this->separation = separation;
     }
 
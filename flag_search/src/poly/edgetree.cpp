@@ -0,0 +1,72 @@
+/**
+ * The MIT License (MIT)
+ * Copyright (c) 2016 Grabarchuk Viktor
+ * Copyright (c) 2023 Pablo López Sedeño
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#include "edgetree.hpp"
+
+#include <algorithm>
+
+using namespace poly_private;
+
+EdgeTree::EdgeTree() {}
+
+EdgeTree::EdgeTree(std::span<const Box> boxes) {
+    indices.resize(boxes.size());
+    for (uint32_t i = 0; i < indices.size(); ++i) {
+        indices[i] = i;
+    }
+
+    if (!boxes.empty()) {
+        nodes.reserve(2 * boxes.size() / leaf_size + 1);
+        build(boxes, 0, indices.size());
+    }
+}
+
+void EdgeTree::build(std::span<const Box> boxes, uint32_t first, uint32_t last) {
+    Box box{boxes[indices[first]]};
+    for (uint32_t i = first + 1; i < last; ++i) {
+        const Box &other{boxes[indices[i]]};
+        box.min = Point{std::min(box.min.x, other.min.x), std::min(box.min.y, other.min.y)};
+        box.max = Point{std::max(box.max.x, other.max.x), std::max(box.max.y, other.max.y)};
+    }
+
+    size_t node_index{nodes.size()};
+    nodes.push_back(Node{box, first, last - first, 0});
+
+    if (last - first <= leaf_size)
+        return;
+
+    // Median split along the longest side of the box, so the depth is
+    // logarithmic whatever the shape of the polygon
+    bool split_x{box.max.x - box.min.x >= box.max.y - box.min.y};
+    auto center{[&boxes, split_x](uint32_t i) {
+        const Box &b{boxes[i]};
+        return split_x ? b.min.x + b.max.x : b.min.y + b.max.y;
+    }};
+
+    uint32_t middle{first + (last - first) / 2};
+    std::nth_element(indices.begin() + first, indices.begin() + middle, indices.begin() + last,
+                     [&center](uint32_t a, uint32_t b) { return center(a) < center(b); });
+
+    nodes[node_index].count = 0;
+    build(boxes, first, middle);
+    nodes[node_index].right = nodes.size();
+    build(boxes, middle, last);
+}
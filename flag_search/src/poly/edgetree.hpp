@@ -0,0 +1,169 @@
+/**
+ * The MIT License (MIT)
+ * Copyright (c) 2016 Grabarchuk Viktor
+ * Copyright (c) 2023 Pablo López Sedeño
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#pragma once
+
+#include "point.hpp"
+#include <algorithm>
+#include <span>
+#include <vector>
+#include <cstdint>
+
+namespace poly_private {
+/**
+ * @brief Axis aligned bounding box.
+*/
+struct Box {
+    Point min;
+    Point max;
+
+    /**
+     * @brief Returns true if both boxes, grown by the margin, overlap.
+    */
+    bool overlaps(const Box &other, double margin) const {
+        return (min.x - other.max.x <= margin) and (other.min.x - max.x <= margin) and
+               (min.y - other.max.y <= margin) and (other.min.y - max.y <= margin);
+    }
+
+    /**
+     * @brief Returns the distance between the point and the nearest point
+     * of the box, zero if the point is inside.
+    */
+    double distance(const Point &point) const {
+        double dx{std::max({min.x - point.x, 0.0, point.x - max.x})};
+        double dy{std::max({min.y - point.y, 0.0, point.y - max.y})};
+
+        return poly_private::square_root(dx * dx + dy * dy);
+    }
+};
+
+/**
+ * @brief Bounding volume hierarchy over the edges of a polygon, stored as
+ * a flat array of nodes in depth first order.
+*/
+class EdgeTree {
+    public:
+        EdgeTree();
+
+        /**
+         * @brief Builds the tree over the bounding boxes of the edges.
+        */
+        EdgeTree(std::span<const Box> boxes);
+
+        /**
+         * @brief Calls visit with the index of every edge whose box overlaps
+         * the given one grown by the margin, until visit returns false.
+         *
+         * @returns
+         * false if visit returned false.
+        */
+        template <typename F>
+        bool visit_overlapping(const Box &box, double margin, F visit) const {
+            if (nodes.empty())
+                return true;
+
+            uint32_t stack[max_depth];
+            size_t stack_size{0};
+            stack[stack_size++] = 0;
+
+            while (stack_size > 0) {
+                const Node &node{nodes[stack[--stack_size]]};
+                if (!node.box.overlaps(box, margin))
+                    continue;
+
+                if (node.count > 0) {
+                    for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+                        if (!visit(indices[i]))
+                            return false;
+                    }
+                } else {
+                    stack[stack_size++] = node.right;
+                    stack[stack_size++] = static_cast<uint32_t>(&node - nodes.data()) + 1;
+                }
+            }
+
+            return true;
+        }
+
+        /**
+         * @brief Calls visit with the index of the edges that may be nearer
+         * to the point than distance, nearest boxes first. visit must lower
+         * distance when it finds a nearer edge.
+         *
+         * @param
+         * slack: The tolerance added to the box distances before discarding
+         * them, to absorb the rounding of the edge distances.
+        */
+        template <typename F>
+        void visit_nearest(const Point &point, const double &distance, double slack, F visit) const {
+            if (nodes.empty())
+                return;
+
+            uint32_t stack[max_depth];
+            size_t stack_size{0};
+            stack[stack_size++] = 0;
+
+            while (stack_size > 0) {
+                const Node &node{nodes[stack[--stack_size]]};
+                if (node.box.distance(point) - slack > distance)
+                    continue;
+
+                if (node.count > 0) {
+                    for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+                        visit(indices[i]);
+                    }
+                } else {
+                    uint32_t left{static_cast<uint32_t>(&node - nodes.data()) + 1};
+                    uint32_t right{node.right};
+                    if (nodes[left].box.distance(point) < nodes[right].box.distance(point))
+                        std::swap(left, right);
+
+                    stack[stack_size++] = left;
+                    stack[stack_size++] = right;
+                }
+            }
+        }
+
+        bool empty() const {
+            return nodes.empty();
+        }
+
+    private:
+        static constexpr size_t leaf_size{4};
+        static constexpr size_t max_depth{64};
+
+        /**
+         * @brief Leaf if count is not zero. Otherwise the left child is the
+         * next node and right is the index of the right child.
+        */
+        struct Node {
+            Box box;
+            uint32_t first;
+            uint32_t count;
+            uint32_t right;
+        };
+
+        std::vector<Node> nodes;
+        std::vector<uint32_t> indices;
+
+        void build(std::span<const Box> boxes, uint32_t first, uint32_t last);
+};
+};
@@ -0,0 +1,439 @@
+/**
+ * The MIT License (MIT)
+ * Copyright (c) 2016 Grabarchuk Viktor
+ * Copyright (c) 2023 Pablo López Sedeño
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#include "kernels.hpp"
+#include "predicates.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+using namespace poly_private;
+
+namespace {
+/**
+ * @brief One double per register. It is the fallback when there are no
+ * vector instructions and the reference used by the *_scalar kernels.
+*/
+struct ScalarLanes {
+    using Reg = double;
+    using Mask = bool;
+    static constexpr size_t width{1};
+
+    static Reg load(const double *p) { return *p; }
+    static void store(double *p, Reg a) { *p = a; }
+    static Reg set(double v) { return v; }
+    static Reg add(Reg a, Reg b) { return a + b; }
+    static Reg sub(Reg a, Reg b) { return a - b; }
+    static Reg mul(Reg a, Reg b) { return a * b; }
+    static Reg div(Reg a, Reg b) { return a / b; }
+    static Reg min(Reg a, Reg b) { return a < b ? a : b; }
+    static Reg select(Mask m, Reg a, Reg b) { return m ? a : b; }
+    static Mask lt(Reg a, Reg b) { return a < b; }
+    static Mask gt(Reg a, Reg b) { return a > b; }
+    static int bits(Mask m) { return m ? 1 : 0; }
+    static Reg abs(Reg a) { return std::fabs(a); }
+    static double sum(Reg a) { return a; }
+    static double min_of(Reg a) { return a; }
+};
+
+#if defined(__AVX2__)
+struct SimdLanes {
+    using Reg = __m256d;
+    using Mask = __m256d;
+    static constexpr size_t width{4};
+
+    static Reg load(const double *p) { return _mm256_loadu_pd(p); }
+    static void store(double *p, Reg a) { _mm256_storeu_pd(p, a); }
+    static Reg set(double v) { return _mm256_set1_pd(v); }
+    static Reg add(Reg a, Reg b) { return _mm256_add_pd(a, b); }
+    static Reg sub(Reg a, Reg b) { return _mm256_sub_pd(a, b); }
+    static Reg mul(Reg a, Reg b) { return _mm256_mul_pd(a, b); }
+    static Reg div(Reg a, Reg b) { return _mm256_div_pd(a, b); }
+    static Reg min(Reg a, Reg b) { return _mm256_min_pd(a, b); }
+    static Reg select(Mask m, Reg a, Reg b) { return _mm256_blendv_pd(b, a, m); }
+    static Mask lt(Reg a, Reg b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+    static Mask gt(Reg a, Reg b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+    static int bits(Mask m) { return _mm256_movemask_pd(m); }
+    static Reg abs(Reg a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+
+    static double sum(Reg a) {
+        alignas(32) double v[4];
+        _mm256_store_pd(v, a);
+        return (v[0] + v[1]) + (v[2] + v[3]);
+    }
+
+    static double min_of(Reg a) {
+        alignas(32) double v[4];
+        _mm256_store_pd(v, a);
+        return ScalarLanes::min(ScalarLanes::min(v[0], v[1]), ScalarLanes::min(v[2], v[3]));
+    }
+
+    static constexpr const char *name{"AVX2"};
+};
+#elif defined(__SSE2__)
+struct SimdLanes {
+    using Reg = __m128d;
+    using Mask = __m128d;
+    static constexpr size_t width{2};
+
+    static Reg load(const double *p) { return _mm_loadu_pd(p); }
+    static void store(double *p, Reg a) { _mm_storeu_pd(p, a); }
+    static Reg set(double v) { return _mm_set1_pd(v); }
+    static Reg add(Reg a, Reg b) { return _mm_add_pd(a, b); }
+    static Reg sub(Reg a, Reg b) { return _mm_sub_pd(a, b); }
+    static Reg mul(Reg a, Reg b) { return _mm_mul_pd(a, b); }
+    static Reg div(Reg a, Reg b) { return _mm_div_pd(a, b); }
+    static Reg min(Reg a, Reg b) { return _mm_min_pd(a, b); }
+    static Reg select(Mask m, Reg a, Reg b) { return _mm_or_pd(_mm_and_pd(m, a), _mm_andnot_pd(m, b)); }
+    static Mask lt(Reg a, Reg b) { return _mm_cmplt_pd(a, b); }
+    static Mask gt(Reg a, Reg b) { return _mm_cmpgt_pd(a, b); }
+    static int bits(Mask m) { return _mm_movemask_pd(m); }
+    static Reg abs(Reg a) { return _mm_andnot_pd(_mm_set1_pd(-0.0), a); }
+
+    static double sum(Reg a) {
+        alignas(16) double v[2];
+        _mm_store_pd(v, a);
+        return v[0] + v[1];
+    }
+
+    static double min_of(Reg a) {
+        alignas(16) double v[2];
+        _mm_store_pd(v, a);
+        return ScalarLanes::min(v[0], v[1]);
+    }
+
+    static constexpr const char *name{"SSE2"};
+};
+#else
+struct SimdLanes : public ScalarLanes {
+    static constexpr const char *name{"scalar"};
+};
+#endif
+
+/**
+ * @brief Processes the elements from first to the last multiple of the
+ * lane width, and returns the index of the first element left.
+*/
+template <typename L, typename F>
+size_t for_each_block(size_t first, size_t last, F block) {
+    size_t i{first};
+    for (; i + L::width <= last; i += L::width) {
+        block(i);
+    }
+
+    return i;
+}
+
+template <typename L>
+double signed_square_kernel(const VertexArray &array) {
+    const double *x{array.x.data()};
+    const double *y{array.y.data()};
+    typename L::Reg sum{L::set(0)};
+
+    size_t i{for_each_block<L>(0, array.size, [&](size_t i) {
+        sum = L::add(sum, L::mul(L::load(x + i + 1), L::sub(L::load(y + i), L::load(y + i + 2))));
+    })};
+
+    double result{L::sum(sum)};
+    for (; i < array.size; ++i) {
+        result += x[i + 1] * (y[i] - y[i + 2]);
+    }
+
+    return result / 2.0;
+}
+
+template <typename L>
+double clockwise_sum_kernel(const VertexArray &array) {
+    const double *x{array.x.data()};
+    const double *y{array.y.data()};
+    typename L::Reg sum{L::set(0)};
+
+    size_t i{for_each_block<L>(0, array.size, [&](size_t i) {
+        sum = L::add(sum, L::mul(L::sub(L::load(x + i + 2), L::load(x + i + 1)),
+                                 L::add(L::load(y + i + 2), L::load(y + i + 1))));
+    })};
+
+    double result{L::sum(sum)};
+    for (; i < array.size; ++i) {
+        result += (x[i + 2] - x[i + 1]) * (y[i + 2] + y[i + 1]);
+    }
+
+    return result;
+}
+
+template <typename L>
+typename L::Reg sq_distance(typename L::Reg sx, typename L::Reg sy, typename L::Reg ex, typename L::Reg ey,
+                            typename L::Reg px, typename L::Reg py) {
+    typename L::Reg dx{L::sub(ex, sx)};
+    typename L::Reg dy{L::sub(ey, sy)};
+
+    typename L::Reg u{L::div(L::add(L::mul(L::sub(px, sx), dx), L::mul(L::sub(py, sy), dy)),
+                             L::add(L::mul(dx, dx), L::mul(dy, dy)))};
+
+    typename L::Reg nx{L::add(sx, L::mul(dx, u))};
+    typename L::Reg ny{L::add(sy, L::mul(dy, u))};
+    typename L::Mask before{L::lt(u, L::set(0))};
+    typename L::Mask after{L::gt(u, L::set(1))};
+    nx = L::select(before, sx, L::select(after, ex, nx));
+    ny = L::select(before, sy, L::select(after, ey, ny));
+
+    typename L::Reg ox{L::sub(nx, px)};
+    typename L::Reg oy{L::sub(ny, py)};
+
+    return L::add(L::mul(ox, ox), L::mul(oy, oy));
+}
+
+template <typename L>
+typename L::Reg sq_distance_block(const double *x, const double *y,
+                                  typename L::Reg px, typename L::Reg py) {
+    return sq_distance<L>(L::load(x), L::load(y), L::load(x + 1), L::load(y + 1), px, py);
+}
+
+template <typename L>
+double min_distance_kernel(const VertexArray &array, const Point &point) {
+    const double *x{array.x.data()};
+    const double *y{array.y.data()};
+    const typename L::Reg px{L::set(point.x)};
+    const typename L::Reg py{L::set(point.y)};
+    typename L::Reg best{L::set(std::numeric_limits<double>::infinity())};
+
+    // Degenerate edges give NaN, which min discards like the scalar loops do
+    size_t i{for_each_block<L>(0, array.size, [&](size_t i) {
+        best = L::min(sq_distance_block<L>(x + i + 1, y + i + 1, px, py), best);
+    })};
+
+    double result{L::min_of(best)};
+    for (; i < array.size; ++i) {
+        result = ScalarLanes::min(sq_distance_block<ScalarLanes>(x + i + 1, y + i + 1, point.x, point.y), result);
+    }
+
+    return sqrt(result);
+}
+
+/**
+ * @brief Returns true if the edge crosses the vertical line through the
+ * point above it, using the exact orientation.
+*/
+bool crosses_above(const double *x, const double *y, const Point &point) {
+    const Point start{x[0], y[0]};
+    const Point end{x[1], y[1]};
+
+    if ((start.x > point.x) == (end.x > point.x))
+        return false;
+
+    double side{predicates::orient2d(start, end, point)};
+
+    return (end.x > start.x) ? (side < 0) : (side > 0);
+}
+
+/**
+ * @brief Returns one bit per lane telling whether the edge crosses the
+ * vertical line through the point above it. An edge is counted when its
+ * end points are on different sides of the line, the one on the line
+ * belonging to the left side, so a vertex on the ray is only counted once.
+ * The orientations are filtered in floating point, and the lanes whose
+ * sign is uncertain are returned in uncertain to be evaluated again with
+ * exact arithmetic.
+*/
+template <typename L>
+int crossing_bits(typename L::Reg x1, typename L::Reg y1, typename L::Reg x2, typename L::Reg y2,
+                  typename L::Reg px, typename L::Reg py, int &uncertain) {
+    int straddle{L::bits(L::gt(x1, px)) ^ L::bits(L::gt(x2, px))};
+    if (straddle == 0) {
+        uncertain = 0;
+        return 0;
+    }
+
+    typename L::Reg det_left{L::mul(L::sub(x1, px), L::sub(y2, py))};
+    typename L::Reg det_right{L::mul(L::sub(y1, py), L::sub(x2, px))};
+    typename L::Reg det{L::sub(det_left, det_right)};
+    typename L::Reg bound{L::mul(L::set(predicates::orient2d_error_bound),
+                                 L::add(L::abs(det_left), L::abs(det_right)))};
+
+    int rightwards{L::bits(L::gt(x2, x1))};
+    int negative{L::bits(L::lt(det, L::sub(L::set(0), bound)))};
+    int positive{L::bits(L::gt(det, bound))};
+    uncertain = straddle & ~(negative | positive);
+
+    return straddle & ((rightwards & negative) | (~rightwards & positive));
+}
+
+/**
+ * @brief Counts the edges of the block that cross the vertical line
+ * through the point above it.
+*/
+template <typename L>
+int crossing_block(const double *x, const double *y, const Point &point) {
+    int uncertain;
+    int crossed{crossing_bits<L>(L::load(x), L::load(y), L::load(x + 1), L::load(y + 1),
+                                 L::set(point.x), L::set(point.y), uncertain)};
+
+    int result{__builtin_popcount(crossed)};
+    for (size_t lane = 0; lane < L::width; ++lane) {
+        if (uncertain & (1 << lane))
+            result += crosses_above(x + lane, y + lane, point);
+    }
+
+    return result;
+}
+
+template <typename L>
+int crossing_count_kernel(const VertexArray &array, const Point &point) {
+    const double *x{array.x.data()};
+    const double *y{array.y.data()};
+    int result{0};
+
+    size_t i{for_each_block<L>(0, array.size, [&](size_t i) {
+        result += crossing_block<L>(x + i + 1, y + i + 1, point);
+    })};
+
+    for (; i < array.size; ++i) {
+        result += crossing_block<ScalarLanes>(x + i + 1, y + i + 1, point);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Tests a block of points at a time, reading each edge once per
+ * block and processing several points per register.
+*/
+template <typename L>
+void points_inside_kernel(const VertexArray &array, std::span<const Point> points, std::span<uint8_t> inside) {
+    constexpr size_t block_size{256};
+    double px[block_size];
+    double py[block_size];
+    double best[block_size];
+    int crossings[block_size];
+
+    for (size_t first = 0; first < points.size(); first += block_size) {
+        size_t count{std::min(block_size, points.size() - first)};
+        for (size_t j = 0; j < count; ++j) {
+            px[j] = points[first + j].x;
+            py[j] = points[first + j].y;
+            best[j] = std::numeric_limits<double>::infinity();
+            crossings[j] = 0;
+        }
+
+        for (size_t k = 0; k < array.size; ++k) {
+            const double *x{array.x.data() + k + 1};
+            const double *y{array.y.data() + k + 1};
+            const typename L::Reg sx{L::set(x[0])};
+            const typename L::Reg sy{L::set(y[0])};
+            const typename L::Reg ex{L::set(x[1])};
+            const typename L::Reg ey{L::set(y[1])};
+
+            size_t j{for_each_block<L>(0, count, [&](size_t j) {
+                typename L::Reg qx{L::load(px + j)};
+                typename L::Reg qy{L::load(py + j)};
+                L::store(best + j, L::min(sq_distance<L>(sx, sy, ex, ey, qx, qy), L::load(best + j)));
+
+                int uncertain;
+                int crossed{crossing_bits<L>(sx, sy, ex, ey, qx, qy, uncertain)};
+                for (size_t lane = 0; (crossed | uncertain) >> lane; ++lane) {
+                    if (uncertain & (1 << lane))
+                        crossings[j + lane] += crosses_above(x, y, Point{px[j + lane], py[j + lane]});
+                    else
+                        crossings[j + lane] += (crossed >> lane) & 1;
+                }
+            })};
+
+            for (; j < count; ++j) {
+                best[j] = ScalarLanes::min(sq_distance<ScalarLanes>(x[0], y[0], x[1], y[1], px[j], py[j]), best[j]);
+                crossings[j] += crossing_block<ScalarLanes>(x, y, Point{px[j], py[j]});
+            }
+        }
+
+        for (size_t j = 0; j < count; ++j) {
+            inside[first + j] = (sqrt(best[j]) <= POLY_SPLIT_EPS) or (crossings[j] % 2 != 0);
+        }
+    }
+}
+};
+
+VertexArray::VertexArray() : size{0} {}
+
+VertexArray::VertexArray(const Points &vertices) : size{vertices.size()} {
+    x.resize(size + 2);
+    y.resize(size + 2);
+
+    if (size > 0) {
+        x[0] = vertices[size - 1].x;
+        y[0] = vertices[size - 1].y;
+
+        for (size_t i = 0; i < size; ++i) {
+            x[i + 1] = vertices[i].x;
+            y[i + 1] = vertices[i].y;
+        }
+
+        x[size + 1] = vertices[0].x;
+        y[size + 1] = vertices[0].y;
+    }
+}
+
+double poly_private::signed_square(const VertexArray &array) {
+    return signed_square_kernel<SimdLanes>(array);
+}
+
+double poly_private::signed_square_scalar(const VertexArray &array) {
+    return signed_square_kernel<ScalarLanes>(array);
+}
+
+double poly_private::clockwise_sum(const VertexArray &array) {
+    return clockwise_sum_kernel<SimdLanes>(array);
+}
+
+double poly_private::clockwise_sum_scalar(const VertexArray &array) {
+    return clockwise_sum_kernel<ScalarLanes>(array);
+}
+
+double poly_private::min_distance(const VertexArray &array, const Point &point) {
+    return min_distance_kernel<SimdLanes>(array, point);
+}
+
+double poly_private::min_distance_scalar(const VertexArray &array, const Point &point) {
+    return min_distance_kernel<ScalarLanes>(array, point);
+}
+
+int poly_private::crossing_count(const VertexArray &array, const Point &point) {
+    return crossing_count_kernel<SimdLanes>(array, point);
+}
+
+int poly_private::crossing_count_scalar(const VertexArray &array, const Point &point) {
+    return crossing_count_kernel<ScalarLanes>(array, point);
+}
+
+void poly_private::points_inside(const VertexArray &array, std::span<const Point> points, std::span<uint8_t> inside) {
+    points_inside_kernel<SimdLanes>(array, points, inside);
+}
+
+void poly_private::points_inside_scalar(const VertexArray &array, std::span<const Point> points, std::span<uint8_t> inside) {
+    points_inside_kernel<ScalarLanes>(array, points, inside);
+}
+
+const char *poly_private::kernel_instruction_set(void) {
+    return SimdLanes::name;
+}
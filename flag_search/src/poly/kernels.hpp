@@ -0,0 +1,81 @@
+/**
+ * The MIT License (MIT)
+ * Copyright (c) 2016 Grabarchuk Viktor
+ * Copyright (c) 2023 Pablo López Sedeño
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#pragma once
+
+#include "point.hpp"
+#include <cstdint>
+#include <span>
+
+namespace poly_private {
+/**
+ * @brief Structure-of-arrays copy of the vertex ring used by the vectorized
+ * scans. The arrays are padded with the last vertex before the first one and
+ * with the first vertex after the last one, so vertex i is at index i + 1 and
+ * its neighbours can be loaded without wrapping around.
+*/
+struct VertexArray {
+    VertexArray();
+    VertexArray(const Points &vertices);
+
+    size_t size;
+    std::vector<double> x;
+    std::vector<double> y;
+};
+
+/**
+ * @brief Returns the same value as Polygon::count_square_signed.
+*/
+double signed_square(const VertexArray &array);
+double signed_square_scalar(const VertexArray &array);
+
+/**
+ * @brief Returns the sum whose sign tells the orientation in Polygon::is_clockwise.
+*/
+double clockwise_sum(const VertexArray &array);
+double clockwise_sum_scalar(const VertexArray &array);
+
+/**
+ * @brief Returns the distance between the point and the nearest edge.
+*/
+double min_distance(const VertexArray &array, const Point &point);
+double min_distance_scalar(const VertexArray &array, const Point &point);
+
+/**
+ * @brief Returns the number of edges crossed by a vertical ray cast upwards
+ * from the point. The vertices on the ray are counted once, and the
+ * result is exact except for the points lying on an edge.
+*/
+int crossing_count(const VertexArray &array, const Point &point);
+int crossing_count_scalar(const VertexArray &array, const Point &point);
+
+/**
+ * @brief Sets inside to 1 for the points that are within POLY_SPLIT_EPS of
+ * an edge or have an odd crossing_count, and to 0 for the rest.
+*/
+void points_inside(const VertexArray &array, std::span<const Point> points, std::span<uint8_t> inside);
+void points_inside_scalar(const VertexArray &array, std::span<const Point> points, std::span<uint8_t> inside);
+
+/**
+ * @brief Returns the name of the instruction set used by the vectorized scans.
+*/
+const char *kernel_instruction_set(void);
+};
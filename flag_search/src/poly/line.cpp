@@ -20,6 +20,7 @@
 */
 
 #include "line.hpp"
+#include "predicates.hpp"
 
 #include <cassert>
 #include <cmath>
@@ -32,14 +33,6 @@ Line::Line() {
     p2 = Point{};
 }
 
-Line::Line(const Line &other) {
-    a = other.a;
-    b = other.b;
-    c = other.c;
-    p1 = other.p1;
-    p2 = other.p2;
-}
-
 Line::Line(const Point &p1, const Point &p2) : p1(p1), p2(p2) {
     a = p1.y - p2.y;
     b = p2.x - p1.x;
@@ -84,7 +77,7 @@ Point Line::get_nearest_point(const Point &point) const {
 }
 
 PointSide Line::point_side(const Point &point) const {
-    double s{a * (point.x - p1.x) + b * (point.y - p1.y)};
+    double s{predicates::line_side(a, b, p1, point)};
     if (s > 0) {
         return PointSide::Above;
     } else if (s < 0) {
@@ -125,16 +118,6 @@ bool Line::operator==(const Line &other) const {
     return (point_side(other.p1) == PointSide::Inside) and (point_side(other.p2) == PointSide::Inside);
 }
 
-Line &Line::operator=(const Line &other) {
-    p1 = other.p1;
-    p2 = other.p2;
-    a = other.a;
-    b = other.b;
-    c = other.c;
-
-    return *this;
-}
-
 Line Line::get_bisector(const Line &l1, const Line &l2) {
     if (l1 == l2) {
         return Line{l1};
@@ -38,7 +38,7 @@ class Line {
 
     public:
         Line();
-        Line(const Line &other);
+        Line(const Line &other) = default;
         Line(const Point &p1, const Point &p2);
         Line(double a, double b, double c);
         Line(Point p, Vector v);
@@ -92,7 +92,7 @@ class Line {
 
         bool operator==(const Line &other) const;
 
-        Line &operator=(const Line &other);
+        Line &operator=(const Line &other) = default;
 
         /**
          * @brief Returns the bisector between the two lines
@@ -111,12 +111,10 @@ class Line {
 class Segment {
     private:
         Line l;
-        Point &start = l.p1;
-        Point &end = l.p2;
 
     public:
         Segment();
-        Segment(const Segment &s);
+        Segment(const Segment &s) = default;
         Segment(const Line &l);
         Segment(const Point &start, const Point &end);
         Line make_line() const;
@@ -196,7 +194,7 @@ class Segment {
         bool cross_line(const Segment &seg, Point &result) const;
 
         bool operator==(const Segment &other) const;
-        Segment &operator=(const Segment &other);
+        Segment &operator=(const Segment &other) = default;
 
         /**
          * @brief Returns the bisector between the two lines
@@ -210,3 +208,8 @@ class Segment {
 
         friend std::ostream &operator<<(std::ostream &out, const Segment &s);
 };
+
+static_assert(std::is_trivially_copyable_v<Line> and std::is_standard_layout_v<Line>);
+static_assert(sizeof(Line) == 7 * sizeof(double));
+static_assert(std::is_trivially_copyable_v<Segment> and std::is_standard_layout_v<Segment>);
+static_assert(sizeof(Segment) == sizeof(Line));
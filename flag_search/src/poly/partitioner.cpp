@@ -0,0 +1,333 @@
+/**
+ * The MIT License (MIT)
+ * Copyright (c) 2016 Grabarchuk Viktor
+ * Copyright (c) 2023 Pablo López Sedeño
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#include "partitioner.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <future>
+
+std::vector<Polygon> SequentialPartitioner::partition(const Polygon &area, const unsigned int number_of_polygons) const {
+    std::vector<Polygon> polygons{};
+    if (number_of_polygons == 0)
+        return polygons;
+    polygons.reserve(number_of_polygons);
+
+    double partial_area{area.count_square() / static_cast<double>(number_of_polygons)};
+
+    Polygon helper{area};
+    Polygon poly1;
+    Polygon poly2;
+    Segment cut_line;
+
+    for (unsigned int i = 0; i < number_of_polygons - 1; ++i) {
+        helper.split(partial_area, poly1, poly2, cut_line);
+
+        if (poly1.count_square() - partial_area < poly2.count_square() - partial_area) {
+            polygons.push_back(std::move(poly1));
+            helper = std::move(poly2);
+        } else {
+            polygons.push_back(std::move(poly2));
+            helper = std::move(poly1);
+        }
+    }
+
+    polygons.push_back(std::move(helper));
+
+    return polygons;
+}
+
+std::vector<Polygon> BisectionPartitioner::partition(const Polygon &area, const unsigned int number_of_polygons) const {
+    std::vector<Polygon> polygons(number_of_polygons);
+    if (number_of_polygons > 0)
+        bisect(Polygon{area}, number_of_polygons, polygons.begin());
+
+    return polygons;
+}
+
+void BisectionPartitioner::bisect(Polygon &&area, const unsigned int number_of_polygons, std::vector<Polygon>::iterator first) const {
+    if (number_of_polygons == 1) {
+        *first = std::move(area);
+        return;
+    }
+
+    const unsigned int first_half{(number_of_polygons + 1) / 2};
+    const unsigned int second_half{number_of_polygons / 2};
+    const double square{area.count_square() * second_half / number_of_polygons};
+
+    Polygon poly1;
+    Polygon poly2;
+    Segment cut_line;
+
+    area.split(square, poly1, poly2, cut_line);
+
+    Polygon *first_area{&poly1};
+    Polygon *second_area{&poly2};
+    if (fabs(poly1.count_square() - square) < fabs(poly2.count_square() - square)) {
+        first_area = &poly2;
+        second_area = &poly1;
+    }
+
+    std::future<void> first_task{std::async(std::launch::async,
+        [this, first_area, first_half, first]() {
+            bisect(std::move(*first_area), first_half, first);
+        }
+    )};
+
+    bisect(std::move(*second_area), second_half, first + first_half);
+
+    first_task.get();
+}
+
+namespace {
+/**
+ * @brief Area of a polygon below each of the lines parallel to a direction,
+ * given by its offset along the normal of the direction.
+*/
+class StripAreas {
+    public:
+        StripAreas(const Points &vertices, const Vector &normal) {
+            for (const Point &vertex : vertices)
+                levels.push_back(normal.dot(Vector{vertex}));
+            std::sort(levels.begin(), levels.end());
+            levels.erase(std::unique(levels.begin(), levels.end()), levels.end());
+
+            // The width of the polygon along each line changes linearly
+            // between two levels, with the edges that begin or end at them
+            size_t m{levels.size()};
+            std::vector<double> width_steps(m, 0);
+            std::vector<double> slope_steps(m, 0);
+            Vector direction{-normal.y, normal.x};
+            for (size_t i = 0; i < vertices.size(); ++i) {
+                const Point &start{vertices[i]};
+                const Point &end{vertices[(i + 1) % vertices.size()]};
+                double start_level{normal.dot(Vector{start})};
+                double end_level{normal.dot(Vector{end})};
+                if (start_level == end_level)
+                    continue;
+
+                double sign{(end_level > start_level) ? 1.0 : -1.0};
+                double slope{(direction.dot(Vector{end}) - direction.dot(Vector{start})) / (end_level - start_level)};
+                const Point &low{(sign > 0) ? start : end};
+                const Point &high{(sign > 0) ? end : start};
+                size_t low_index{find_index(std::min(start_level, end_level))};
+                size_t high_index{find_index(std::max(start_level, end_level))};
+
+                width_steps[low_index] += sign * direction.dot(Vector{low});
+                slope_steps[low_index] += sign * slope;
+                width_steps[high_index] -= sign * direction.dot(Vector{high});
+                slope_steps[high_index] -= sign * slope;
+            }
+
+            widths.assign(m, 0);
+            slopes.assign(m, 0);
+            areas.assign(m, 0);
+            double width{0};
+            double slope{0};
+            for (size_t k = 0; k + 1 < m; ++k) {
+                width += width_steps[k];
+                slope += slope_steps[k];
+                widths[k] = width;
+                slopes[k] = slope;
+
+                double step{levels[k + 1] - levels[k]};
+                areas[k + 1] = areas[k] + width * step + slope * step * step / 2;
+                width += slope * step;
+            }
+
+            // The widths are negative if the polygon turns clockwise
+            if (!areas.empty() and (areas.back() < 0)) {
+                for (size_t k = 0; k < m; ++k) {
+                    widths[k] = -widths[k];
+                    slopes[k] = -slopes[k];
+                    areas[k] = -areas[k];
+                }
+            }
+        }
+
+        double get_area() const {
+            return areas.empty() ? 0 : areas.back();
+        }
+
+        /**
+         * @brief Returns the offset of the line with the given area below it.
+        */
+        double find_offset(double area) const {
+            size_t k{static_cast<size_t>(std::upper_bound(areas.begin(), areas.end(), area) - areas.begin())};
+            k = std::clamp<size_t>(k, 1, levels.size() - 1) - 1;
+
+            // Solves width * s + slope * s^2 / 2 = remaining without cancellation
+            double remaining{area - areas[k]};
+            double discriminant{std::max(widths[k] * widths[k] + 2 * slopes[k] * remaining, 0.0)};
+            double denominator{widths[k] + std::sqrt(discriminant)};
+            double step{levels[k + 1] - levels[k]};
+            double s{(denominator > 0) ? 2 * remaining / denominator : step};
+
+            return levels[k] + std::clamp(s, 0.0, step);
+        }
+
+    private:
+        std::vector<double> levels;
+        std::vector<double> widths;
+        std::vector<double> slopes;
+        std::vector<double> areas;
+
+        /**
+         * @brief Returns the index of an offset that is in levels.
+        */
+        size_t find_index(double level) const {
+            return static_cast<size_t>(std::lower_bound(levels.begin(), levels.end(), level) - levels.begin());
+        }
+};
+
+/**
+ * @brief Checks if every line parallel to the direction crosses the polygon
+ * along a single segment, which happens when its offset along the normal
+ * rises and falls only once around the polygon.
+*/
+bool is_monotone(const Points &vertices, const Vector &normal) {
+    size_t turns{0};
+    int previous{0};
+    int first{0};
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        double start_level{normal.dot(Vector{vertices[i]})};
+        double end_level{normal.dot(Vector{vertices[(i + 1) % vertices.size()]})};
+        if (start_level == end_level)
+            continue;
+
+        int step{(end_level > start_level) ? 1 : -1};
+        if (first == 0)
+            first = step;
+        else if (step != previous)
+            ++turns;
+        previous = step;
+    }
+
+    if (previous != first)
+        ++turns;
+
+    return turns <= 2;
+}
+}
+
+StripPartitioner::StripPartitioner() {}
+
+StripPartitioner::StripPartitioner(const Vector &direction) : direction{direction} {}
+
+std::vector<Polygon> StripPartitioner::partition(const Polygon &area, const unsigned int number_of_polygons) const {
+    std::vector<Polygon> polygons{};
+    if (number_of_polygons == 0)
+        return polygons;
+    if (number_of_polygons == 1) {
+        polygons.push_back(area);
+        return polygons;
+    }
+
+    const Points &vertices{area.get_vertices()};
+    if (vertices.size() < 3)
+        throw Polygon::CannotSplitException{"The polygon has not enough vertices"};
+
+    Vector normal{(direction ? *direction : Vector{vertices[1] - vertices[0]}).unit().norm()};
+    if (normal == Vector{})
+        throw Polygon::CannotSplitException{"The direction of the strips is null"};
+
+    const StripAreas strip_areas{vertices, normal};
+    if (!(strip_areas.get_area() > 0))
+        throw Polygon::CannotSplitException{"The polygon has no area"};
+
+    // Some cut line would cross the area more than twice and leave a strip
+    // in several parts
+    if (!is_monotone(vertices, normal))
+        throw Polygon::CannotSplitException{"The polygon is not monotone along the strips"};
+
+    std::vector<double> cuts(number_of_polygons - 1);
+    for (unsigned int j = 1; j < number_of_polygons; ++j)
+        cuts[j - 1] = strip_areas.find_offset(strip_areas.get_area() * j / number_of_polygons);
+
+    // Each edge leaves its start in the strips that contain it and the
+    // points where it crosses a cut line in the strips on both sides,
+    // which clips the polygon against every strip in a single pass
+    std::vector<Points> strips(number_of_polygons);
+    std::vector<std::vector<size_t>> strip_cuts(number_of_polygons);
+    const size_t no_cut{cuts.size()};
+    auto add{[&](size_t strip, const Point &point, size_t cut) {
+        if (strips[strip].empty() or !(strips[strip].back() == point)) {
+            strips[strip].push_back(point);
+            strip_cuts[strip].push_back(cut);
+        }
+    }};
+
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        const Point &start{vertices[i]};
+        const Point &end{vertices[(i + 1) % vertices.size()]};
+        double start_level{normal.dot(Vector{start})};
+        double end_level{normal.dot(Vector{end})};
+
+        size_t first{static_cast<size_t>(std::lower_bound(cuts.begin(), cuts.end(), start_level) - cuts.begin())};
+        if ((first < cuts.size()) and (cuts[first] == start_level)) {
+            add(first, start, first);
+            add(first + 1, start, first);
+        } else {
+            add(first, start, no_cut);
+        }
+
+        auto cross{[&](size_t cut) {
+            double t{(cuts[cut] - start_level) / (end_level - start_level)};
+            Point point{start + Vector{end - start} * t};
+            add(cut, point, cut);
+            add(cut + 1, point, cut);
+        }};
+
+        if (end_level > start_level) {
+            for (size_t cut = static_cast<size_t>(std::upper_bound(cuts.begin(), cuts.end(), start_level) - cuts.begin());
+                 (cut < cuts.size()) and (cuts[cut] < end_level); ++cut)
+                cross(cut);
+        } else if (end_level < start_level) {
+            for (size_t cut = first; (cut > 0) and (cuts[cut - 1] > end_level); --cut)
+                cross(cut - 1);
+        }
+    }
+
+    polygons.reserve(number_of_polygons);
+    for (size_t j = 0; j < number_of_polygons; ++j) {
+        Points &strip{strips[j]};
+        std::vector<size_t> &on_cut{strip_cuts[j]};
+        while ((strip.size() > 1) and (strip.back() == strip.front())) {
+            strip.pop_back();
+            on_cut.pop_back();
+        }
+        if (strip.size() < 3)
+            throw Polygon::CannotSplitException{"A strip of the polygon is empty"};
+
+        // The strip begins with an edge along a cut line
+        size_t n{strip.size()};
+        for (size_t k = 0; k < n; ++k) {
+            if ((on_cut[k] != no_cut) and (on_cut[k] == on_cut[(k + 1) % n])) {
+                std::rotate(strip.begin(), strip.begin() + static_cast<std::ptrdiff_t>(k), strip.end());
+                break;
+            }
+        }
+
+        polygons.emplace_back(std::move(strip));
+    }
+
+    return polygons;
+}
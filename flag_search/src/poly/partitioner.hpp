@@ -0,0 +1,98 @@
+/**
+ * The MIT License (MIT)
+ * Copyright (c) 2016 Grabarchuk Viktor
+ * Copyright (c) 2023 Pablo López Sedeño
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#pragma once
+
+#include "polygon.hpp"
+
+/**
+ * @brief Strategy used to divide an area into polygons of the same area.
+*/
+struct AreaPartitioner {
+    virtual ~AreaPartitioner() {}
+
+    /**
+     * @brief Divides the area into number_of_polygons polygons of the same area.
+     *
+     * @throws
+     * Polygon::CannotSplitException: if the area cannot be divided.
+    */
+    virtual std::vector<Polygon> partition(const Polygon &area, const unsigned int number_of_polygons) const = 0;
+};
+
+/**
+ * @brief Peels off one polygon after another, so the longest chain of
+ * dependent splits has number_of_polygons - 1 steps.
+*/
+struct SequentialPartitioner : public AreaPartitioner {
+    std::vector<Polygon> partition(const Polygon &area, const unsigned int number_of_polygons) const override;
+};
+
+/**
+ * @brief Splits the area in a ceil(N/2):floor(N/2) ratio and divides both
+ * halves recursively in separate threads, so the longest chain of dependent
+ * splits has log2(number_of_polygons) steps.
+*/
+struct BisectionPartitioner : public AreaPartitioner {
+    std::vector<Polygon> partition(const Polygon &area, const unsigned int number_of_polygons) const override;
+
+    private:
+        /**
+         * @brief Divides the area, which is moved into first when it is
+         * not divided any more.
+        */
+        void bisect(Polygon &&area, const unsigned int number_of_polygons, std::vector<Polygon>::iterator first) const;
+};
+
+/**
+ * @brief Cuts the area with lines parallel to a direction, so each polygon
+ * is a strip across the area. The cut offsets are found with a binary search
+ * over the area below each line, which grows quadratically between the
+ * vertices. The strips are simple polygons if every cut line crosses the
+ * area along a single segment. Otherwise a strip could be made of several
+ * parts, so an area that is not monotone along the normal of the direction
+ * is rejected. The caller can divide such an area with SequentialPartitioner.
+*/
+struct StripPartitioner : public AreaPartitioner {
+    /**
+     * @brief The cut lines follow the first edge of each area, which is
+     * also the direction of the passes of ParallelSweep.
+    */
+    StripPartitioner();
+
+    /**
+     * @brief The cut lines follow the given direction.
+    */
+    explicit StripPartitioner(const Vector &direction);
+
+    /**
+     * @brief Divides the area into strips. Each strip begins with an edge
+     * along one of its cut lines.
+     *
+     * @throws
+     * Polygon::CannotSplitException: if the area or the direction is null,
+     * or if the area is not monotone along the normal of the direction.
+    */
+    std::vector<Polygon> partition(const Polygon &area, const unsigned int number_of_polygons) const override;
+
+    private:
+        std::optional<Vector> direction;
+};
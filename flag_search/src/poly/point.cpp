@@ -23,77 +23,6 @@
 
 #include <cmath>
 
-Point Point::operator-() const {
-    return Point{-x, -y};
-}
-
-Point &Point::operator+=(const Point &p) {
-    x += p.x;
-    y += p.y;
-
-    return *this;
-}
-
-Point &Point::operator-=(const Point &p) {
-    x -= p.x;
-    y -= p.y;
-
-    return *this;
-}
-
-Point &Point::operator*=(double p) {
-    x *= p;
-    y *= p;
-
-    return *this;
-}
-
-Point &Point::operator/=(double p) {
-    x /= p;
-    y /= p;
-
-    return *this;
-}
-
-Point Point::operator-(const Point &p) const {
-    return Point{x - p.x, y - p.y};
-}
-
-Point Point::operator+(const Point &p) const {
-    return Point{x + p.x, y + p.y};
-}
-
-Point Point::operator*(const double p) const {
-    return Point{x * p, y * p};
-}
-
-Point Point::operator/(const double p) const {
-    return Point{x / p, y / p};
-}
-
-bool Point::operator==(const Point &p) const {
-    return fabs(x - p.x) <= POLY_SPLIT_EPS && fabs(y - p.y) <= POLY_SPLIT_EPS;
-}
-
-bool Point::operator!=(const Point &p) const {
-    return fabs(x - p.x) > POLY_SPLIT_EPS || fabs(y - p.y) > POLY_SPLIT_EPS;
-}
-
-double Point::distance(const Point &p) const {
-    return sqrt(square_distance(p));
-}
-
-double Point::square_distance(const Point &p) const {
-    double dx = fabs(x - p.x);
-    double dy = fabs(y - p.y);
-
-    return dx * dx + dy * dy;
-}
-
-Point Point::abs() const {
-    return Point{fabs(x), fabs(y)};
-}
-
 Point::operator std::string() const {
     return "(" + std::to_string(x) + ", " + std::to_string(y) + ")";
 }
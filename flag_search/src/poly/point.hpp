@@ -24,32 +24,205 @@
 #include <ostream>
 #include <vector>
 #include <limits>
+#include <type_traits>
+#include <cmath>
+#include <string>
 
-const double POLY_SPLIT_EPS = 1E-6;
+constexpr double POLY_SPLIT_EPS = 1E-6;
+
+namespace poly_private {
+/**
+ * @brief Same as fabs, but it can also be evaluated at compile time.
+*/
+constexpr double absolute(double v) {
+    if (std::is_constant_evaluated())
+        return (v < 0) ? -v : v;
+
+    return std::fabs(v);
+}
+
+/**
+ * @brief Same as sqrt, but it can also be evaluated at compile time.
+*/
+constexpr double square_root(double v) {
+    if (std::is_constant_evaluated()) {
+        if (v <= 0)
+            return 0;
+
+        // The first guess is above the root, so the iterates go down until
+        // the rounding stops them. Comparing them for equality instead may
+        // never end if they alternate between two neighbouring values.
+        double result{v >= 1 ? v : 1};
+        for (double next{(result + v / result) / 2}; next < result; next = (result + v / result) / 2) {
+            result = next;
+        }
+
+        return result;
+    }
+
+    return std::sqrt(v);
+}
+};
 
 struct Point {
     double x, y;
 
-    Point(double x = 0.0f, double y = 0.0f) : x(x), y(y) {};
-
-    Point operator-() const;
-    Point &operator+=(const Point &p);
-    Point &operator-=(const Point &p);
-    Point &operator*=(double p);
-    Point &operator/=(double p);
-    Point operator-(const Point &p) const;
-    Point operator+(const Point &p) const;
-    Point operator*(const double p) const;
-    Point operator/(const double p) const;
-    bool operator==(const Point &p) const;
-    bool operator!=(const Point &p) const;
+    constexpr Point(double x = 0.0f, double y = 0.0f) : x(x), y(y) {};
+
+    constexpr Point operator-() const {
+        return Point{-x, -y};
+    }
+
+    constexpr Point &operator+=(const Point &p) {
+        x += p.x;
+        y += p.y;
+
+        return *this;
+    }
+
+    constexpr Point &operator-=(const Point &p) {
+        x -= p.x;
+        y -= p.y;
+
+        return *this;
+    }
+
+    constexpr Point &operator*=(double p) {
+        x *= p;
+        y *= p;
+
+        return *this;
+    }
+
+    constexpr Point &operator/=(double p) {
+        x /= p;
+        y /= p;
+
+        return *this;
+    }
+
+    constexpr Point operator-(const Point &p) const {
+        return Point{x - p.x, y - p.y};
+    }
+
+    constexpr Point operator+(const Point &p) const {
+        return Point{x + p.x, y + p.y};
+    }
+
+    constexpr Point operator*(const double p) const {
+        return Point{x * p, y * p};
+    }
+
+    constexpr Point operator/(const double p) const {
+        return Point{x / p, y / p};
+    }
+
+    constexpr bool operator==(const Point &p) const {
+        return poly_private::absolute(x - p.x) <= POLY_SPLIT_EPS && poly_private::absolute(y - p.y) <= POLY_SPLIT_EPS;
+    }
+
+    constexpr bool operator!=(const Point &p) const {
+        return poly_private::absolute(x - p.x) > POLY_SPLIT_EPS || poly_private::absolute(y - p.y) > POLY_SPLIT_EPS;
+    }
+
     operator std::string() const;
-    double distance(const Point &p) const;
-    double square_distance(const Point &p) const;
-    Point abs() const;
+
+    constexpr double distance(const Point &p) const {
+        return poly_private::square_root(square_distance(p));
+    }
+
+    constexpr double square_distance(const Point &p) const {
+        double dx = poly_private::absolute(x - p.x);
+        double dy = poly_private::absolute(y - p.y);
+
+        return dx * dx + dy * dy;
+    }
+
+    constexpr Point abs() const {
+        return Point{poly_private::absolute(x), poly_private::absolute(y)};
+    }
+
     friend std::ostream& operator<<(std::ostream &out, const Point &v);
 };
 
+static_assert(std::is_trivially_copyable_v<Point> and std::is_standard_layout_v<Point>);
+static_assert(sizeof(Point) == 2 * sizeof(double));
+
 using Points = std::vector<Point>;
 using PointIter = std::vector<Point>::iterator;
-using CPointIter = std::vector<Point>::const_iterator;
\ No newline at end of file
+using CPointIter = std::vector<Point>::const_iterator;
+
+namespace poly_private {
+/**
+ * @brief Returns the same as Polygon::count_square_signed for the vertices
+ * of any container, also at compile time.
+*/
+template <typename Vertices>
+constexpr double count_square_signed(const Vertices &vertices) {
+    size_t points_count{std::size(vertices)};
+    if (points_count < 3) {
+        return 0;
+    }
+
+    double result{0};
+    for (size_t i = 0; i < points_count; i++) {
+        const Point &previous{vertices[(i + points_count - 1) % points_count]};
+        const Point &next{vertices[(i + 1) % points_count]};
+        result += vertices[i].x * (previous.y - next.y);
+    }
+
+    return result / 2.0;
+}
+
+/**
+ * @brief Returns the same as Polygon::count_square for the vertices of any
+ * container, also at compile time.
+*/
+template <typename Vertices>
+constexpr double count_square(const Vertices &vertices) {
+    return poly_private::absolute(count_square_signed(vertices));
+}
+
+/**
+ * @brief Returns the lower left corner of the bounding box of the vertices.
+*/
+template <typename Vertices>
+constexpr Point find_min_corner(const Vertices &vertices) {
+    Point result{vertices[0]};
+    for (const Point &vertex : vertices) {
+        result.x = (vertex.x < result.x) ? vertex.x : result.x;
+        result.y = (vertex.y < result.y) ? vertex.y : result.y;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Returns the upper right corner of the bounding box of the vertices.
+*/
+template <typename Vertices>
+constexpr Point find_max_corner(const Vertices &vertices) {
+    Point result{vertices[0]};
+    for (const Point &vertex : vertices) {
+        result.x = (vertex.x > result.x) ? vertex.x : result.x;
+        result.y = (vertex.y > result.y) ? vertex.y : result.y;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Returns the same as Polygon::find_center for the vertices of any
+ * container, also at compile time.
+*/
+template <typename Vertices>
+constexpr Point find_center(const Vertices &vertices) {
+    Point result;
+    for (const Point &vertex : vertices) {
+        result += vertex;
+    }
+    result /= static_cast<double>(std::size(vertices));
+
+    return result;
+}
+};
@@ -0,0 +1,147 @@
+/**
+ * The MIT License (MIT)
+ * Copyright (c) 2016 Grabarchuk Viktor
+ * Copyright (c) 2023 Pablo López Sedeño
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#include "pointlocator.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace poly_private;
+
+PointLocator::PointLocator() : cell_width{0}, cell_height{0}, columns{0}, rows{0} {}
+
+PointLocator::PointLocator(const Points &vertices, double margin) : PointLocator() {
+    if (vertices.size() < 3)
+        return;
+
+    min = poly_private::find_min_corner(vertices);
+    max = poly_private::find_max_corner(vertices);
+    if (!(max.x > min.x) or !(max.y > min.y))
+        return;
+
+    // About four cells per vertex, so each cell is crossed by few edges
+    size_t side{static_cast<size_t>(2 * std::ceil(std::sqrt(static_cast<double>(vertices.size()))))};
+    side = std::clamp(side, min_cells_per_side, max_cells_per_side);
+    columns = side;
+    rows = side;
+    cell_width = (max.x - min.x) / static_cast<double>(columns);
+    cell_height = (max.y - min.y) / static_cast<double>(rows);
+    cells.assign(columns * rows, Location::Outside);
+
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        mark_boundary(vertices[i], vertices[(i + 1) % vertices.size()], margin);
+    }
+
+    classify_rows(vertices);
+}
+
+PointLocator::Location PointLocator::locate(const Point &point) const {
+    if (cells.empty() or !(point.x >= min.x) or !(point.x <= max.x) or !(point.y >= min.y) or !(point.y <= max.y))
+        return Location::Boundary;
+
+    size_t column{std::min(static_cast<size_t>((point.x - min.x) / cell_width), columns - 1)};
+    size_t row{std::min(static_cast<size_t>((point.y - min.y) / cell_height), rows - 1)};
+
+    return cells[row * columns + column];
+}
+
+void PointLocator::get_range(double low, double high, double origin, double size, size_t count,
+                             size_t &first, size_t &last) {
+    double low_cell{std::floor((low - origin) / size)};
+    double high_cell{std::floor((high - origin) / size)};
+
+    first = static_cast<size_t>(std::clamp(low_cell, 0.0, static_cast<double>(count - 1)));
+    last = static_cast<size_t>(std::clamp(high_cell, 0.0, static_cast<double>(count - 1)));
+}
+
+void PointLocator::mark_boundary(const Point &start, const Point &end, double margin) {
+    size_t first_row, last_row;
+    get_range(std::min(start.y, end.y) - margin, std::max(start.y, end.y) + margin,
+              min.y, cell_height, rows, first_row, last_row);
+
+    const Point dir{end - start};
+
+    for (size_t row = first_row; row <= last_row; ++row) {
+        // Part of the edge inside the row, grown by the margin
+        double y_low{min.y + static_cast<double>(row) * cell_height - margin};
+        double y_high{y_low + cell_height + 2 * margin};
+        double t_low{0};
+        double t_high{1};
+
+        if (dir.y != 0) {
+            double t_a{(y_low - start.y) / dir.y};
+            double t_b{(y_high - start.y) / dir.y};
+            t_low = std::max(t_low, std::min(t_a, t_b));
+            t_high = std::min(t_high, std::max(t_a, t_b));
+
+            if (t_low > t_high)
+                continue;
+        }
+
+        double x_a{start.x + dir.x * t_low};
+        double x_b{start.x + dir.x * t_high};
+        size_t first_column, last_column;
+        get_range(std::min(x_a, x_b) - margin, std::max(x_a, x_b) + margin,
+                  min.x, cell_width, columns, first_column, last_column);
+
+        for (size_t column = first_column; column <= last_column; ++column) {
+            cells[row * columns + column] = Location::Boundary;
+        }
+    }
+}
+
+void PointLocator::classify_rows(const Points &vertices) {
+    // Abscissas where the edges cross the horizontal line through the
+    // center of each row, counting the vertices on it only once
+    std::vector<std::vector<double>> crossings(rows);
+
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        const Point &start{vertices[i]};
+        const Point &end{vertices[(i + 1) % vertices.size()]};
+
+        size_t first_row, last_row;
+        get_range(std::min(start.y, end.y) - cell_height, std::max(start.y, end.y),
+                  min.y, cell_height, rows, first_row, last_row);
+
+        for (size_t row = first_row; row <= last_row; ++row) {
+            double y{min.y + (static_cast<double>(row) + 0.5) * cell_height};
+            if ((start.y > y) != (end.y > y))
+                crossings[row].push_back(start.x + (y - start.y) * (end.x - start.x) / (end.y - start.y));
+        }
+    }
+
+    for (size_t row = 0; row < rows; ++row) {
+        std::vector<double> &xs{crossings[row]};
+        std::sort(xs.begin(), xs.end());
+
+        size_t crossed{0};
+        for (size_t column = 0; column < columns; ++column) {
+            double x{min.x + (static_cast<double>(column) + 0.5) * cell_width};
+            while ((crossed < xs.size()) and (xs[crossed] < x)) {
+                ++crossed;
+            }
+
+            Location &cell{cells[row * columns + column]};
+            if (cell != Location::Boundary)
+                cell = (crossed % 2 == 1) ? Location::Inside : Location::Outside;
+        }
+    }
+}
@@ -0,0 +1,83 @@
+/**
+ * The MIT License (MIT)
+ * Copyright (c) 2016 Grabarchuk Viktor
+ * Copyright (c) 2023 Pablo López Sedeño
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#pragma once
+
+#include "point.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace poly_private {
+/**
+ * @brief Uniform grid over the bounding box of a polygon whose cells are
+ * classified as inside, outside or crossed by the boundary, so most point
+ * location queries are answered with a single lookup.
+*/
+class PointLocator {
+    public:
+        enum class Location : uint8_t {
+            Outside,
+            Inside,
+            Boundary
+        };
+
+        PointLocator();
+
+        /**
+         * @brief Builds the grid for the polygon with the given vertices.
+         * The cells nearer than margin to an edge are classified as
+         * boundary.
+        */
+        PointLocator(const Points &vertices, double margin);
+
+        /**
+         * @brief Returns the location of the cell containing the point, or
+         * boundary if the point is outside the grid.
+        */
+        Location locate(const Point &point) const;
+
+        bool empty() const {
+            return cells.empty();
+        }
+
+    private:
+        static constexpr size_t min_cells_per_side{8};
+        static constexpr size_t max_cells_per_side{512};
+
+        Point min;
+        Point max;
+        double cell_width;
+        double cell_height;
+        size_t columns;
+        size_t rows;
+        std::vector<Location> cells;
+
+        void mark_boundary(const Point &start, const Point &end, double margin);
+        void classify_rows(const Points &vertices);
+
+        /**
+         * @brief Returns the range of cells along one axis that overlap the
+         * interval from low to high, both included.
+        */
+        static void get_range(double low, double high, double origin, double size, size_t count,
+                              size_t &first, size_t &last);
+};
+};
@@ -20,11 +20,15 @@
 */
 
 #include "polygon.hpp"
+#include "predicates.hpp"
 
 #include <cfloat>
 #include <algorithm>
 #include <exception>
+#include <stdexcept>
 #include <cmath>
+#include <atomic>
+#include <thread>
 
 using namespace poly_private;
 
@@ -161,6 +165,177 @@ bool Polygons::find_cut_line(double square, Segment &cut_line) {
     return false;
 }
 
+SquarePrefix::SquarePrefix(const Points &polygon) : polygon{polygon} {
+    size_t polygon_size{polygon.size()};
+
+    if (polygon_size > 0)
+        origin = polygon[0];
+
+    prefix.resize(polygon_size + 1);
+    prefix[0] = 0;
+    for (size_t i = 0; i < polygon_size; ++i) {
+        prefix[i + 1] = prefix[i] + cross(polygon[i], polygon[(i + 1) % polygon_size]);
+    }
+}
+
+double SquarePrefix::cross(const Point &p1, const Point &p2) const {
+    return (p1.x - origin.x) * (p2.y - origin.y) - (p2.x - origin.x) * (p1.y - origin.y);
+}
+
+double SquarePrefix::chain_square_signed(size_t first, size_t last) const {
+    size_t polygon_size{polygon.size()};
+    if ((last + polygon_size - first) % polygon_size + 1 < 3) {
+        return 0;
+    }
+
+    double result;
+    if (first <= last)
+        result = prefix[last] - prefix[first];
+    else
+        result = prefix[polygon_size] - prefix[first] + prefix[last];
+
+    result += cross(polygon[last], polygon[first]);
+
+    return -result / 2.0;
+}
+
+double poly_private::point_segment_distance(const Point &point, const Point &start, const Point &end) {
+    Vector dir{end - start};
+    double sq_length{dir.square_length()};
+    if (sq_length == 0)
+        return point.distance(start);
+
+    double u{Vector{point - start}.dot(dir) / sq_length};
+    if (u < 0)
+        return point.distance(start);
+    else if (u > 1)
+        return point.distance(end);
+    else
+        return point.distance(start + dir * u);
+}
+
+static double orientation(const Point &p1, const Point &p2, const Point &p3) {
+    return (p2.x - p1.x) * (p3.y - p1.y) - (p2.y - p1.y) * (p3.x - p1.x);
+}
+
+EdgePair::EdgePair(const Points &polygon, int i, int j) : i{i}, j{j} {
+    int polygon_size{static_cast<int>(polygon.size())};
+    const Point &a1{polygon[i]};
+    const Point &a2{polygon[(i + 1) % polygon_size]};
+    const Point &b1{polygon[j]};
+    const Point &b2{polygon[(j + 1) % polygon_size]};
+
+    double o1{orientation(a1, a2, b1)};
+    double o2{orientation(a1, a2, b2)};
+    double o3{orientation(b1, b2, a1)};
+    double o4{orientation(b1, b2, a2)};
+
+    if ((o1 * o2 <= 0) and (o3 * o4 <= 0)) {
+        bound = 0;
+    } else {
+        bound = std::min({point_segment_distance(a1, b1, b2),
+                          point_segment_distance(a2, b1, b2),
+                          point_segment_distance(b1, a1, a2),
+                          point_segment_distance(b2, a1, a2)});
+    }
+}
+
+bool EdgePair::can_improve(double sq_length) const {
+    // The ends of a cut line may lie slightly outside the edges
+    double slack{4 * POLY_SPLIT_EPS + bound * POLY_SPLIT_EPS};
+    double min_length{std::max(bound - slack, 0.0)};
+
+    return min_length * min_length <= sq_length;
+}
+
+bool EdgePair::operator<(const EdgePair &other) const {
+    return bound < other.bound;
+}
+
+std::vector<EdgePair> poly_private::get_sorted_edge_pairs(const Points &polygon) {
+    int polygon_size{static_cast<int>(polygon.size())};
+    std::vector<EdgePair> pairs{};
+    pairs.reserve(static_cast<size_t>(polygon_size) * (polygon_size - 1) / 2);
+
+    for (int i = 0; i < polygon_size - 1; i++) {
+        for (int j = i + 1; j < polygon_size; j++) {
+            pairs.push_back(EdgePair{polygon, i, j});
+        }
+    }
+
+    std::sort(pairs.begin(), pairs.end());
+
+    return pairs;
+}
+
+std::vector<EdgePair> poly_private::get_convex_edge_pairs(const Points &polygon, const SquarePrefix &square_prefix,
+                                                         double square) {
+    int polygon_size{static_cast<int>(polygon.size())};
+    double total_square{fabs(square_prefix.chain_square_signed(0, polygon_size - 1))};
+    double slack{total_square * POLY_SPLIT_EPS + POLY_SPLIT_EPS};
+    double rest{total_square - square};
+
+    // Areas of the chains before and after the quadrilateral of the pair
+    auto first_chain{[&](int i, int j) {
+        return fabs(square_prefix.chain_square_signed(i + 1, j));
+    }};
+    auto second_chain{[&](int i, int j) {
+        return fabs(square_prefix.chain_square_signed((j + 1) % polygon_size, i));
+    }};
+
+    // The cut goes forward when square is between the second chain and the
+    // rest of the polygon, and backward when it is between the first one
+    // and the rest. All the bounds only move forward as i grows.
+    int forward_first{1};
+    int forward_last{0};
+    int backward_first{1};
+    int backward_last{0};
+
+    std::vector<EdgePair> pairs{};
+    for (int i = 0; i < polygon_size - 1; i++) {
+        forward_first = std::max(forward_first, i + 1);
+        while ((forward_first < polygon_size) and (second_chain(i, forward_first) >= square + slack))
+            ++forward_first;
+
+        forward_last = std::max(forward_last, i);
+        while ((forward_last + 1 < polygon_size) and (first_chain(i, forward_last + 1) <= rest + slack))
+            ++forward_last;
+
+        backward_first = std::max(backward_first, i + 1);
+        while ((backward_first < polygon_size) and (second_chain(i, backward_first) > rest + slack))
+            ++backward_first;
+
+        backward_last = std::max(backward_last, i);
+        while ((backward_last + 1 < polygon_size) and (first_chain(i, backward_last + 1) < square + slack))
+            ++backward_last;
+
+        for (int j = forward_first; j <= forward_last; j++) {
+            pairs.push_back(EdgePair{polygon, i, j});
+        }
+
+        for (int j = backward_first; j <= backward_last; j++) {
+            if ((j < forward_first) or (j > forward_last))
+                pairs.push_back(EdgePair{polygon, i, j});
+        }
+    }
+
+    std::sort(pairs.begin(), pairs.end());
+
+    return pairs;
+}
+
+bool CutCandidate::is_better_than(const CutCandidate &other) const {
+    if (!exists)
+        return false;
+
+    if (!other.exists)
+        return true;
+
+    return (sq_length < other.sq_length) or
+           ((sq_length == other.sq_length) and
+            ((i < other.i) or ((i == other.i) and (j < other.j))));
+}
+
 Polygon::NotEnoughPointsException::NotEnoughPointsException() {}
 
 Polygon::NotEnoughPointsException::NotEnoughPointsException(const std::string &message) {
@@ -189,46 +364,63 @@ const char *Polygon::CannotSplitException::what() const noexcept {
     return message.c_str();
 }
 
+Polygon::SelfIntersectionException::SelfIntersectionException() {}
+
+Polygon::SelfIntersectionException::SelfIntersectionException(const std::string &message) {
+    this->message = std::string{message};
+}
+
+Polygon::SelfIntersectionException::SelfIntersectionException(const char *message) {
+    this->message = std::string{message};
+}
+
+const char *Polygon::SelfIntersectionException::what() const noexcept {
+    return message.c_str();
+}
+
 Polygon::Polygon() {}
 
 Polygon::Polygon(const Polygon &p) {
     vertices = p.vertices;
 }
 
+Polygon::Polygon(Polygon &&p) noexcept {
+    take(p);
+}
+
 Polygon::Polygon(const Points &p) {
     vertices = p;
 }
 
-double Polygon::count_square_signed(void) const {
-    size_t pointsCount{vertices.size()};
-    if (pointsCount < 3) {
-        return 0;
-    }
-
-    double result{0};
-    for (size_t i = 0; i < pointsCount; i++) {
-        if (i == 0)
-            result += vertices[i].x * (vertices[pointsCount - 1].y - vertices[i + 1].y);
-        else if (i == pointsCount - 1)
-            result += vertices[i].x * (vertices[i - 1].y - vertices[0].y);
-        else
-            result += vertices[i].x * (vertices[i - 1].y - vertices[i + 1].y);
-    }
+Polygon::Polygon(Points &&p) {
+    vertices = std::move(p);
+}
 
-    return result / 2.0;
+double Polygon::count_square_signed(void) const {
+    return get_properties().square_signed;
 }
 
 double Polygon::count_square() const {
     return fabs(count_square_signed());
 }
 
-void Polygon::split(double square, Polygon &poly1, Polygon &poly2, Segment &cut_line) const {
-    int polygon_size{static_cast<int>(vertices.size())};
+void Polygon::split(double square, Polygon &poly1, Polygon &poly2, Segment &cut_line,
+                    SplitStatistics *statistics) const {
+    search_cut(square, poly1, poly2, cut_line, 1, statistics);
+}
 
-    Points polygon{vertices};
-    if (!is_clockwise()) {
-        std::reverse(polygon.begin(), polygon.end());
-    }
+void Polygon::split_parallel(double square, Polygon &poly1, Polygon &poly2, Segment &cut_line,
+                             unsigned int n_threads, SplitStatistics *statistics) const {
+    if (n_threads == 0)
+        n_threads = std::max(std::thread::hardware_concurrency(), 1u);
+
+    search_cut(square, poly1, poly2, cut_line, n_threads, statistics);
+}
+
+void Polygon::search_cut(double square, Polygon &poly1, Polygon &poly2, Segment &cut_line,
+                         unsigned int n_threads, SplitStatistics *statistics) const {
+    int polygon_size{static_cast<int>(vertices.size())};
+    Points polygon{get_clockwise_vertices()};
 
     poly1.clear();
     poly2.clear();
@@ -238,151 +430,622 @@ void Polygon::split(double square, Polygon &poly1, Polygon &poly2, Segment &cut_
         throw Polygon::CannotSplitException{"The required area is too big"};
     }
 
-    bool min_cut_line_exists{false};
-    double min_sq_length = DBL_MAX;
+    // In a convex polygon only a few pairs can leave the required area
+    SquarePrefix square_prefix{polygon};
+    std::vector<EdgePair> pairs{is_convex() ? get_convex_edge_pairs(polygon, square_prefix, square)
+                                            : get_sorted_edge_pairs(polygon)};
+    size_t total_pairs{static_cast<size_t>(polygon_size) * (polygon_size - 1) / 2};
+
+    const size_t chunk_size{64};
+    std::atomic<size_t> next_pair{0};
+    std::atomic<size_t> evaluated_pairs{0};
+    std::atomic<double> min_sq_length{DBL_MAX};
+    std::vector<CutCandidate> best_cuts(n_threads);
+    std::vector<std::exception_ptr> errors(n_threads);
+
+    // The pairs are visited from the nearest to the farthest, so a worker
+    // stops as soon as a pair cannot beat the best cut found by anyone.
+    // Each worker keeps its own best cut, and ties are resolved by (i, j)
+    // to choose the same cut as an ordered scan.
+    auto worker{[&](unsigned int id) {
+        CutCandidate &best{best_cuts[id]};
+        size_t evaluated{0};
+        bool cont{true};
+
+        try {
+            while (cont) {
+                size_t first{next_pair.fetch_add(chunk_size)};
+                if (first >= pairs.size())
+                    break;
+
+                size_t last{std::min(first + chunk_size, pairs.size())};
+                for (size_t k = first; (k < last) and cont; ++k) {
+                    const EdgePair &pair{pairs[k]};
+                    if (!pair.can_improve(min_sq_length.load(std::memory_order_relaxed))) {
+                        cont = false;
+                        break;
+                    }
+
+                    ++evaluated;
+
+                    CutCandidate candidate;
+                    candidate.i = pair.i;
+                    candidate.j = pair.j;
+
+                    double p1_square{square_prefix.chain_square_signed(pair.i + 1, pair.j)};
+                    double p2_square{square_prefix.chain_square_signed((pair.j + 1) % polygon_size, pair.i)};
+
+                    Line l1{polygon[pair.i], polygon[pair.i + 1]};
+                    Line l2{polygon[pair.j], polygon[(pair.j + 1) < polygon_size ? (pair.j + 1) : 0]};
+                    std::optional<Polygons> forward;
+                    std::optional<Polygons> backward;
+
+                    if (get_cut(l1, l2, square, p1_square, p2_square, forward, backward, candidate.line)) {
+                        candidate.exists = true;
+                        candidate.sq_length = candidate.line.square_length();
+
+                        if (candidate.is_better_than(best) and
+                            (candidate.sq_length <= min_sq_length.load(std::memory_order_relaxed)) and
+                            is_segment_inside(candidate.line, pair.i, pair.j)) {
+                            best = candidate;
+
+                            double current{min_sq_length.load()};
+                            while ((best.sq_length < current) and
+                                   !min_sq_length.compare_exchange_weak(current, best.sq_length)) {}
+                        }
+                    }
+                }
+            }
+        } catch (...) {
+            errors[id] = std::current_exception();
+        }
 
-    for (int i = 0; i < polygon_size - 1; i++) {
-        for (int j = i + 1; j < polygon_size; j++) {
-            Polygon p1;
-            Polygon p2;
-
-            p1.clear();
-            p2.clear();
-            
-            int pc1{j - i};
-            for (int z = 1; z <= pc1; ++z) {
-                p1.push_back(polygon[z + i]);
+        evaluated_pairs += evaluated;
+    }};
+
+    if (n_threads == 1) {
+        worker(0);
+    } else {
+        std::vector<std::thread> workers{};
+        for (unsigned int id = 0; id < n_threads; ++id) {
+            workers.push_back(std::thread{worker, id});
+        }
+
+        for (std::thread &th : workers) {
+            th.join();
+        }
+    }
+
+    for (std::exception_ptr error : errors) {
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+    CutCandidate min_cut;
+    for (const CutCandidate &candidate : best_cuts) {
+        if (candidate.is_better_than(min_cut))
+            min_cut = candidate;
+    }
+
+    if (statistics != nullptr) {
+        statistics->evaluated_pairs = evaluated_pairs;
+        statistics->pruned_pairs = total_pairs - evaluated_pairs;
+    }
+
+    if (min_cut.exists) {
+        cut_line = min_cut.line;
+        build_split(polygon, min_cut, poly1, poly2);
+    } else {
+        poly1 = Polygon{polygon};
+        throw Polygon::CannotSplitException{"The cut line does not exists"};
+    }
+}
+
+std::vector<Polygon::SplitResult> Polygon::split_many(std::span<const double> areas) const {
+    int polygon_size{static_cast<int>(vertices.size())};
+    Points polygon{get_clockwise_vertices()};
+    double total_square{count_square()};
+
+    for (double square : areas) {
+        if (total_square - square <= POLY_SPLIT_EPS)
+            throw Polygon::CannotSplitException{"The required area is too big"};
+    }
+
+    SquarePrefix square_prefix{polygon};
+    std::vector<EdgePair> pairs{get_sorted_edge_pairs(polygon)};
+    std::vector<CutCandidate> min_cuts(areas.size());
+
+    for (const EdgePair &pair : pairs) {
+        double max_sq_length{0};
+        for (const CutCandidate &min_cut : min_cuts) {
+            max_sq_length = std::max(max_sq_length, min_cut.sq_length);
+        }
+
+        if (!pair.can_improve(max_sq_length))
+            break;
+
+        double p1_square{square_prefix.chain_square_signed(pair.i + 1, pair.j)};
+        double p2_square{square_prefix.chain_square_signed((pair.j + 1) % polygon_size, pair.i)};
+
+        Line l1{polygon[pair.i], polygon[pair.i + 1]};
+        Line l2{polygon[pair.j], polygon[(pair.j + 1) < polygon_size ? (pair.j + 1) : 0]};
+        std::optional<Polygons> forward;
+        std::optional<Polygons> backward;
+
+        for (size_t k = 0; k < areas.size(); ++k) {
+            if (!pair.can_improve(min_cuts[k].sq_length))
+                continue;
+
+            CutCandidate candidate;
+            candidate.i = pair.i;
+            candidate.j = pair.j;
+
+            if (get_cut(l1, l2, areas[k], p1_square, p2_square, forward, backward, candidate.line)) {
+                candidate.exists = true;
+                candidate.sq_length = candidate.line.square_length();
+
+                if (candidate.is_better_than(min_cuts[k]) and
+                    is_segment_inside(candidate.line, pair.i, pair.j)) {
+                    min_cuts[k] = candidate;
+                }
+            }
+        }
+    }
+
+    std::vector<SplitResult> results(areas.size());
+    for (size_t k = 0; k < areas.size(); ++k) {
+        if (!min_cuts[k].exists)
+            throw Polygon::CannotSplitException{"The cut line does not exists"};
+
+        results[k].cut_line = min_cuts[k].line;
+        build_split(polygon, min_cuts[k], results[k].poly1, results[k].poly2);
+    }
+
+    return results;
+}
+
+void Polygon::build_split(const Points &polygon, const CutCandidate &cut,
+                          Polygon &poly1, Polygon &poly2) {
+    int polygon_size{static_cast<int>(polygon.size())};
+
+    int pc1{cut.j - cut.i};
+    Points vertices1;
+    vertices1.reserve(pc1 + 2);
+    for (int z = 1; z <= pc1; ++z) {
+        vertices1.push_back(polygon[z + cut.i]);
+    }
+
+    int pc2{polygon_size - pc1};
+    Points vertices2;
+    vertices2.reserve(pc2 + 2);
+    for (int z = 1; z <= pc2; ++z) {
+        vertices2.push_back(polygon[(z + cut.j) % polygon_size]);
+    }
+
+    vertices1.push_back(cut.line.get_start());
+    vertices1.push_back(cut.line.get_end());
+
+    vertices2.push_back(cut.line.get_end());
+    vertices2.push_back(cut.line.get_start());
+
+    poly1 = Polygon{std::move(vertices1)};
+    poly2 = Polygon{std::move(vertices2)};
+}
+
+Points Polygon::get_clockwise_vertices(void) const {
+    Points polygon{vertices};
+    if (!is_clockwise()) {
+        std::reverse(polygon.begin(), polygon.end());
+    }
+
+    return polygon;
+}
+
+const std::vector<Polygon::Edge> &Polygon::get_edges(void) const {
+    if (!edges_ready.load(std::memory_order_acquire)) {
+        cache_mut.lock();
+        if (!edges_ready.load(std::memory_order_relaxed)) {
+            size_t poly_size{vertices.size()};
+            edges.clear();
+            edges.reserve(poly_size);
+
+            for (size_t i = 0; i < poly_size; ++i) {
+                const Point &start{vertices[i]};
+                const Point &end{vertices[(i + 1) % poly_size]};
+                Edge edge{Segment{start, end}, Vector{end - start}, 0,
+                          Point{std::min(start.x, end.x), std::min(start.y, end.y)},
+                          Point{std::max(start.x, end.x), std::max(start.y, end.y)}};
+                edge.inv_sq_length = 1.0 / edge.dir.square_length();
+                edges.push_back(edge);
             }
 
-            int pc2{polygon_size - pc1};
-            for (int z = 1; z <= pc2; ++z) {
-                p2.push_back(polygon[(z + j) % polygon_size]);
+            ++cache_statistics.edge_builds;
+            edges_ready.store(true, std::memory_order_release);
+        }
+        cache_mut.unlock();
+    }
+
+    return edges;
+}
+
+const VertexArray &Polygon::get_vertex_array(void) const {
+    if (!vertex_array_ready.load(std::memory_order_acquire)) {
+        cache_mut.lock();
+        if (!vertex_array_ready.load(std::memory_order_relaxed)) {
+            vertex_array = VertexArray{vertices};
+            ++cache_statistics.vertex_array_builds;
+            vertex_array_ready.store(true, std::memory_order_release);
+        }
+        cache_mut.unlock();
+    }
+
+    return vertex_array;
+}
+
+const EdgeTree &Polygon::get_edge_tree(void) const {
+    if (!edge_tree_ready.load(std::memory_order_acquire)) {
+        const std::vector<Edge> &edge_table{get_edges()};
+
+        cache_mut.lock();
+        if (!edge_tree_ready.load(std::memory_order_relaxed)) {
+            if (edge_table.size() >= index_min_size) {
+                std::vector<Box> boxes;
+                boxes.reserve(edge_table.size());
+                for (const Edge &edge : edge_table) {
+                    boxes.push_back(Box{edge.min, edge.max});
+                }
+
+                edge_tree = EdgeTree{boxes};
+            } else {
+                edge_tree = EdgeTree{};
             }
 
-            Line l1{polygon[i], polygon[i + 1]};
-            Line l2{polygon[j], polygon[(j + 1) < polygon_size ? (j + 1) : 0]};
-            Segment cut;
+            ++cache_statistics.edge_tree_builds;
+            edge_tree_ready.store(true, std::memory_order_release);
+        }
+        cache_mut.unlock();
+    }
 
-            if (get_cut(l1, l2, square, p1, p2, cut)) {
-                double sq_length{cut.square_length()};
+    return edge_tree;
+}
 
-                if (sq_length < min_sq_length && is_segment_inside(cut, i, j)) {
-                    min_sq_length = sq_length;
-                    poly1 = p1;
-                    poly2 = p2;
-                    cut_line = cut;
-                    min_cut_line_exists = true;
+const PointLocator &Polygon::get_point_locator(void) const {
+    if (!point_locator_ready.load(std::memory_order_acquire)) {
+        cache_mut.lock();
+        if (!point_locator_ready.load(std::memory_order_relaxed)) {
+            if (vertices.size() >= index_min_size)
+                point_locator = PointLocator{vertices, 4 * POLY_SPLIT_EPS};
+            else
+                point_locator = PointLocator{};
+
+            ++cache_statistics.point_locator_builds;
+            point_locator_ready.store(true, std::memory_order_release);
+        }
+        cache_mut.unlock();
+    }
+
+    return point_locator;
+}
+
+const Polygon::Properties &Polygon::get_properties(void) const {
+    if (!properties_ready.load(std::memory_order_acquire)) {
+        const VertexArray &array{get_vertex_array()};
+
+        cache_mut.lock();
+        if (!properties_ready.load(std::memory_order_relaxed)) {
+            size_t n{vertices.size()};
+            properties.square_signed = (n < 3) ? 0 : signed_square(array);
+            properties.clockwise = (n < 2) ? false : clockwise_sum(array) <= 0;
+
+            if (n > 0) {
+                properties.min = poly_private::find_min_corner(vertices);
+                properties.max = poly_private::find_max_corner(vertices);
+
+                Point center;
+                for (Point v : vertices) {
+                    center += v;
                 }
+                center /= static_cast<double>(n);
+                properties.center = center;
             }
+
+            ++cache_statistics.property_builds;
+            properties_ready.store(true, std::memory_order_release);
         }
+        cache_mut.unlock();
     }
 
-    if (min_cut_line_exists) {
-        poly1.push_back(cut_line.get_start());
-        poly1.push_back(cut_line.get_end());
+    return properties;
+}
 
-        poly2.push_back(cut_line.get_end());
-        poly2.push_back(cut_line.get_start());
-    } else {
-        poly1 = Polygon{polygon};
-        throw Polygon::CannotSplitException{"The cut line does not exists"};
+/**
+ * @brief Returns the value of Polygon::convexity for the vertices.
+*/
+static int find_convexity(const Points &vertices) {
+    size_t n{vertices.size()};
+    if (n < 3)
+        return 0;
+
+    int turn{0};
+    int x_changes{0};
+    int y_changes{0};
+    double last_dx{0};
+    double last_dy{0};
+    for (size_t i = 0; i <= n; ++i) {
+        const Point &a{vertices[i % n]};
+        const Point &b{vertices[(i + 1) % n]};
+        const Point &c{vertices[(i + 2) % n]};
+
+        double orientation{predicates::orient2d(a, b, c)};
+        if (orientation == 0) {
+            // Aligned vertices must go on in the same direction
+            if (Vector{b - a}.dot(Vector{c - b}) <= 0)
+                return 0;
+        } else if (turn == 0) {
+            turn = (orientation > 0) ? 1 : -1;
+        } else if ((orientation > 0) != (turn > 0)) {
+            return 0;
+        }
+
+        // A polygon that turns always to the same side is only simple if
+        // its edges change their direction in each axis twice
+        double dx{b.x - a.x};
+        double dy{b.y - a.y};
+        if (dx != 0) {
+            x_changes += (last_dx != 0) and ((dx > 0) != (last_dx > 0));
+            last_dx = dx;
+        }
+        if (dy != 0) {
+            y_changes += (last_dy != 0) and ((dy > 0) != (last_dy > 0));
+            last_dy = dy;
+        }
     }
+
+    if ((x_changes > 2) or (y_changes > 2))
+        return 0;
+
+    return turn;
 }
 
-double Polygon::find_distance(const Point &point) const {
-    double distance{std::numeric_limits<double>::infinity()};
-    int poly_size{static_cast<int>(vertices.size())};
-    if (poly_size < 2)
+int Polygon::get_convexity(void) const {
+    if (!convexity_ready.load(std::memory_order_acquire)) {
+        cache_mut.lock();
+        if (!convexity_ready.load(std::memory_order_relaxed)) {
+            convexity = find_convexity(vertices);
+            convexity_ready.store(true, std::memory_order_release);
+        }
+        cache_mut.unlock();
+    }
+
+    return convexity;
+}
+
+const Triangulation &Polygon::triangulate(void) const {
+    if (!triangulation_ready.load(std::memory_order_acquire)) {
+        cache_mut.lock();
+        if (!triangulation_ready.load(std::memory_order_relaxed)) {
+            triangulation = Triangulation{vertices};
+
+            ++cache_statistics.triangulation_builds;
+            triangulation_ready.store(true, std::memory_order_release);
+        }
+        cache_mut.unlock();
+    }
+
+    return triangulation;
+}
+
+Point Polygon::sample_point(double r1, double r2, double r3) const {
+    const Triangulation &triangles{triangulate()};
+    if (triangles.empty())
         throw Polygon::NotEnoughPointsException{"The polygon has not enough vertices"};
 
-    for (int i = 0; i < poly_size - 1; i++) {
-        Segment seg{vertices[i], vertices[i + 1]};
-        Point p{seg.get_nearest_point(point)};
-        double l{p.distance(point)};
-        if (l < distance)
-            distance = l;
+    const Triangulation::Triangle &triangle{triangles.get_triangles()[triangles.find_triangle(r1 * triangles.get_area())]};
+    const Point &a{vertices[triangle[0]]};
+    const Point &b{vertices[triangle[1]]};
+    const Point &c{vertices[triangle[2]]};
+
+    double s{std::sqrt(r2)};
+    return a * (1 - s) + b * (s * (1 - r3)) + c * (s * r3);
+}
+
+PointLocator::Location Polygon::locate_in_fan(const Point &point) const {
+    const double turn{static_cast<double>(get_convexity())};
+    size_t n{vertices.size()};
+    const Point &apex{vertices[0]};
+
+    // Positive when the point is on the inner side of the line from a to b
+    auto side{[&](const Point &a, const Point &b) {
+        return turn * predicates::orient2d(a, b, point);
+    }};
+
+    // True when the point is outside the edge from a to b and farther than
+    // POLY_SPLIT_EPS from it, with room for the rounding errors
+    auto is_far_outside{[&](const Point &a, const Point &b) {
+        double length{a.distance(b)};
+        double cross{(b.x - a.x) * (point.y - a.y) - (b.y - a.y) * (point.x - a.x)};
+        return (length > POLY_SPLIT_EPS) and (turn * cross < -2 * POLY_SPLIT_EPS * length);
+    }};
+
+    if ((side(apex, vertices[1]) <= 0) or (side(vertices[n - 1], apex) <= 0)) {
+        if (is_far_outside(apex, vertices[1]) or is_far_outside(vertices[n - 1], apex))
+            return PointLocator::Location::Outside;
+
+        return PointLocator::Location::Boundary;
+    }
+
+    // The point is between the rays from the apex to first and last
+    size_t first{1};
+    size_t last{n - 1};
+    while (last - first > 1) {
+        size_t middle{first + (last - first) / 2};
+        if (side(apex, vertices[middle]) > 0)
+            first = middle;
+        else
+            last = middle;
     }
-    
-    Segment seg{vertices[poly_size - 1], vertices[0]};
-    Point p{seg.get_nearest_point(point)};
-    double l{p.distance(point)};
-    if (l < distance)
-        distance = l;
 
-    return distance;
+    if (side(vertices[first], vertices[last]) > 0)
+        return PointLocator::Location::Inside;
+
+    if (is_far_outside(vertices[first], vertices[last]))
+        return PointLocator::Location::Outside;
+
+    return PointLocator::Location::Boundary;
 }
 
-Point Polygon::find_nearest_point(const Point &point) const {
-    Point result;
+Polygon::CacheStatistics Polygon::get_cache_statistics(void) const {
+    cache_mut.lock();
+    CacheStatistics result{cache_statistics};
+    cache_mut.unlock();
+
+    return result;
+}
+
+void Polygon::invalidate_cache(void) {
+    edges_ready.store(false, std::memory_order_relaxed);
+    vertex_array_ready.store(false, std::memory_order_relaxed);
+    edge_tree_ready.store(false, std::memory_order_relaxed);
+    point_locator_ready.store(false, std::memory_order_relaxed);
+    properties_ready.store(false, std::memory_order_relaxed);
+    convexity_ready.store(false, std::memory_order_relaxed);
+    triangulation_ready.store(false, std::memory_order_relaxed);
+}
+
+void Polygon::take(Polygon &p) {
+    vertices = std::move(p.vertices);
+    invalidate_cache();
+
+    // The cached data of p remain valid for the same vertices
+    if (p.edges_ready.load(std::memory_order_acquire)) {
+        edges = std::move(p.edges);
+        edges_ready.store(true, std::memory_order_release);
+    }
+    if (p.vertex_array_ready.load(std::memory_order_acquire)) {
+        vertex_array = std::move(p.vertex_array);
+        vertex_array_ready.store(true, std::memory_order_release);
+    }
+    if (p.edge_tree_ready.load(std::memory_order_acquire)) {
+        edge_tree = std::move(p.edge_tree);
+        edge_tree_ready.store(true, std::memory_order_release);
+    }
+    if (p.point_locator_ready.load(std::memory_order_acquire)) {
+        point_locator = std::move(p.point_locator);
+        point_locator_ready.store(true, std::memory_order_release);
+    }
+    if (p.properties_ready.load(std::memory_order_acquire)) {
+        properties = p.properties;
+        properties_ready.store(true, std::memory_order_release);
+    }
+    if (p.convexity_ready.load(std::memory_order_acquire)) {
+        convexity = p.convexity;
+        convexity_ready.store(true, std::memory_order_release);
+    }
+    if (p.triangulation_ready.load(std::memory_order_acquire)) {
+        triangulation = std::move(p.triangulation);
+        triangulation_ready.store(true, std::memory_order_release);
+    }
+
+    p.vertices.clear();
+    p.invalidate_cache();
+}
+
+int Polygon::find_nearest_edge(const Point &point, Point &nearest_point) const {
+    int result{-1};
     double distance{std::numeric_limits<double>::infinity()};
-    int poly_size{static_cast<int>(vertices.size())};
-    if (poly_size < 2)
-        throw Polygon::NotEnoughPointsException{"The polygon has not enough vertices"};
+    const std::vector<Edge> &edge_table{get_edges()};
+
+    // Ties go to the lowest index, so the order of the visits does not matter
+    auto visit{[&](size_t i) {
+        const Edge &edge{edge_table[i]};
+        const Point start{edge.segment.get_start()};
+        double u{Vector{point - start}.dot(edge.dir) * edge.inv_sq_length};
+
+        Point p;
+        if (u < 0)
+            p = start;
+        else if (u > 1)
+            p = edge.segment.get_end();
+        else
+            p = start + edge.dir * u;
 
-    for (int i = 0; i < poly_size - 1; i++) {
-        Segment seg{vertices[i], vertices[i + 1]};
-        Point p{seg.get_nearest_point(point)};
-        double l{(p.distance(point))};
-        if (l < distance) {
+        double l{p.distance(point)};
+        if ((l < distance) or ((l == distance) and (static_cast<int>(i) < result))) {
             distance = l;
-            result = p;
+            result = i;
+            nearest_point = p;
         }
-    }
+    }};
 
-    Segment seg{vertices[poly_size - 1], vertices[0]};
-    Point p{seg.get_nearest_point(point)};
-    double l{(p.distance(point))};
-    if (l < distance) {
-        distance = l;
-        result = p;
+    const EdgeTree &tree{get_edge_tree()};
+    if (tree.empty()) {
+        for (size_t i = 0; i < edge_table.size(); i++) {
+            visit(i);
+        }
+    } else {
+        tree.visit_nearest(point, distance, 4 * POLY_SPLIT_EPS, visit);
     }
 
     return result;
 }
 
+double Polygon::find_distance(const Point &point) const {
+    if (vertices.size() < 2)
+        throw Polygon::NotEnoughPointsException{"The polygon has not enough vertices"};
+
+    // Small polygons have no edge tree and the vectorized scan is faster
+    if (get_edge_tree().empty())
+        return min_distance(get_vertex_array(), point);
+
+    Point nearest_point;
+    find_nearest_edge(point, nearest_point);
+
+    return nearest_point.distance(point);
+}
+
+Point Polygon::find_nearest_point(const Point &point) const {
+    if (vertices.size() < 2)
+        throw Polygon::NotEnoughPointsException{"The polygon has not enough vertices"};
+
+    Point result;
+    find_nearest_edge(point, result);
+
+    return result;
+}
+
 Point Polygon::find_center() const {
     int n{static_cast<int>(vertices.size())};
     if (n <= 0)
         throw Polygon::NotEnoughPointsException{"The polygon has zero vertices"};
 
-    Point result;
-    for (Point v : vertices) {
-        result += v;
-    }
-    result /= n;
+    return get_properties().center;
+}
 
-    return result;
+Point Polygon::find_min_corner() const {
+    if (vertices.empty())
+        throw Polygon::NotEnoughPointsException{"The polygon has zero vertices"};
+
+    return get_properties().min;
+}
+
+Point Polygon::find_max_corner() const {
+    if (vertices.empty())
+        throw Polygon::NotEnoughPointsException{"The polygon has zero vertices"};
+
+    return get_properties().max;
 }
 
 void Polygon::split_nearest_edge(const Point &point) {
-    Point result;
-    int ri{-1};
-    double distance{std::numeric_limits<double>::infinity()};
     int poly_size{static_cast<int>(vertices.size())};
     if (poly_size < 2)
         throw Polygon::NotEnoughPointsException{"The polygon has less than two vertices"};
 
-    for (int i = 0; i < poly_size - 1; i++) {
-        Segment seg{vertices[i], vertices[i + 1]};
-        Point p{seg.get_nearest_point(point)};
-        double l{p.distance(point)};
-        if (l < distance) {
-            distance = l;
-            ri = i;
-            result = p;
-        }
-    }
-    Segment seg{vertices[poly_size - 1], vertices[0]};
-    Point p{seg.get_nearest_point(point)};
-    double l{p.distance(point)};
-    if (l < distance) {
-        distance = l;
-        ri = vertices.size() - 1;
-        result = p;
-    }
+    Point result;
+    int ri{find_nearest_edge(point, result)};
 
-    if ((ri != -1) and (vertices[ri] != result) and (vertices[ri + 1] != result)) {
+    if ((ri != -1) and (vertices[ri] != result) and (vertices[(ri + 1) % poly_size] != result)) {
         vertices.insert(vertices.begin() + ri + 1, result);
+        invalidate_cache();
     }
 }
 
@@ -391,16 +1054,47 @@ bool Polygon::is_point_inside(const Point &point) const {
     if (pointsCount < 2)
         throw Polygon::NotEnoughPointsException{"The polygon has not enough vertices"};
 
-    Segment s{Line{point, Vector{0.0, 1e100}}};
-    int result{0};
-    Point p;
-    for (int i = 0; i < pointsCount; i++) {
-        Segment seg{vertices[i], vertices[i + 1]};
-        result += s.cross_line(seg, p);
+    // Only the points near the boundary need the scans
+    PointLocator::Location location{is_convex() ? locate_in_fan(point) : get_point_locator().locate(point)};
+    if (location != PointLocator::Location::Boundary)
+        return location == PointLocator::Location::Inside;
+
+    if (find_distance(point) <= POLY_SPLIT_EPS)
+        return true;
+
+    return crossing_count(get_vertex_array(), point) % 2 != 0;
+}
+
+void Polygon::contains(std::span<const Point> points, std::span<uint8_t> inside) const {
+    if (vertices.size() < 3)
+        throw Polygon::NotEnoughPointsException{"The polygon has not enough vertices"};
+
+    if (inside.size() < points.size())
+        throw std::invalid_argument{"The output has fewer elements than the points"};
+
+    // The points in the cells crossed by the boundary are tested together
+    const bool convex{is_convex()};
+    const PointLocator *locator{convex ? nullptr : &get_point_locator()};
+    Points pending;
+    std::vector<size_t> pending_index;
+    for (size_t i = 0; i < points.size(); ++i) {
+        PointLocator::Location location{convex ? locate_in_fan(points[i]) : locator->locate(points[i])};
+        if (location == PointLocator::Location::Boundary) {
+            pending.push_back(points[i]);
+            pending_index.push_back(i);
+        } else {
+            inside[i] = location == PointLocator::Location::Inside;
+        }
+    }
+
+    if (pending.empty())
+        return;
+
+    std::vector<uint8_t> pending_inside(pending.size());
+    points_inside(get_vertex_array(), pending, pending_inside);
+    for (size_t i = 0; i < pending.size(); ++i) {
+        inside[pending_index[i]] = pending_inside[i];
     }
-    Segment seg{vertices[pointsCount], vertices[0]};
-    result += s.cross_line(seg, p);
-    return result % 2 != 0;
 }
 
 bool Polygon::is_segment_inside(const Segment &segment, size_t excludeLine1, size_t excludeLine2) const {
@@ -409,53 +1103,77 @@ bool Polygon::is_segment_inside(const Segment &segment, size_t excludeLine1, siz
     if (pointsCount < 3)
         throw Polygon::NotEnoughPointsException{"The polygon has not enough vertices"};
 
-    for (size_t i = 0; i < pointsCount; i++) {
-        if (i != excludeLine1 && i != excludeLine2) {
-            Point p1{vertices[i]};
-            Point p2{vertices[i + 1 < pointsCount ? i + 1 : 0]};
-            Point p;
-            if ((Segment{p1, p2}.cross_line(segment, p)) and
-                (p1.square_distance(p) > POLY_SPLIT_EPS) and
-                (p2.square_distance(p) > POLY_SPLIT_EPS)) {
+    const Point start{segment.get_start()};
+    const Point end{segment.get_end()};
+    const Point min{std::min(start.x, end.x), std::min(start.y, end.y)};
+    const Point max{std::max(start.x, end.x), std::max(start.y, end.y)};
+    const std::vector<Edge> &edge_table{get_edges()};
+
+    auto crosses{[&](size_t i) {
+        if (i == excludeLine1 or i == excludeLine2)
+            return false;
+
+        // Only a proper crossing counts, so the segment may touch the
+        // vertices of the polygon
+        const Edge &edge{edge_table[i]};
+        double edge_start_side{predicates::orient2d(start, end, edge.segment.get_start())};
+        double edge_end_side{predicates::orient2d(start, end, edge.segment.get_end())};
+        double start_side{predicates::orient2d(edge.segment.get_start(), edge.segment.get_end(), start)};
+        double end_side{predicates::orient2d(edge.segment.get_start(), edge.segment.get_end(), end)};
+
+        return (((edge_start_side > 0) and (edge_end_side < 0)) or ((edge_start_side < 0) and (edge_end_side > 0))) and
+               (((start_side > 0) and (end_side < 0)) or ((start_side < 0) and (end_side > 0)));
+    }};
+
+    const EdgeTree &tree{get_edge_tree()};
+    if (tree.empty()) {
+        for (size_t i = 0; i < pointsCount; i++) {
+            const Edge &edge{edge_table[i]};
+
+            // Both segments can only cross if their bounding boxes overlap
+            if (Box{edge.min, edge.max}.overlaps(Box{min, max}, 4 * POLY_SPLIT_EPS) and crosses(i))
                 return false;
-            }
         }
+    } else if (!tree.visit_overlapping(Box{min, max}, 4 * POLY_SPLIT_EPS, [&](size_t i) { return !crosses(i); })) {
+        return false;
     }
 
     return is_point_inside(segment.get_point_along(0.5));
 }
 
+bool Polygon::is_convex() const {
+    return get_convexity() != 0;
+}
+
 bool Polygon::is_clockwise() const {
     if (vertices.size() < 2)
         throw Polygon::NotEnoughPointsException{"The polygon has not enough vertices"};
 
-    double sum{0};
-    int t{static_cast<int>(vertices.size()) - 1};
-    for (int i = 0; i < t; i++) {
-        sum += (vertices[i + 1].x - vertices[i].x) * (vertices[i + 1].y + vertices[i].y);
-    }
-    sum += (vertices[0].x - vertices[t].x) * (vertices[0].y + vertices[t].y);
-    return sum <= 0;
+    return get_properties().clockwise;
 }
 
 bool Polygon::get_cut(const Segment &s1, const Segment &s2, double s,
-            const Polygon &poly1, const Polygon &poly2,
+            double poly1_square, double poly2_square,
+            std::optional<Polygons> &forward,
+            std::optional<Polygons> &backward,
             Segment &cut) {
-    double sn1{s + poly2.count_square_signed()};
-    double sn2{s + poly1.count_square_signed()};
+    double sn1{s + poly2_square};
+    double sn2{s + poly1_square};
 
     bool success{false};
 
     if (sn1 > 0) {
-        Polygons res{s1, s2};
+        if (!forward)
+            forward.emplace(s1, s2);
 
-        if (res.find_cut_line(sn1, cut)) {
+        if (forward->find_cut_line(sn1, cut)) {
             success = true;
         }
     } else if (sn2 > 0) {
-        Polygons res{s2, s1};
+        if (!backward)
+            backward.emplace(s2, s1);
 
-        if (res.find_cut_line(sn2, cut)) {
+        if (backward->find_cut_line(sn2, cut)) {
             cut = cut.reverse();
             success = true;
         }
@@ -466,4 +1184,5 @@ bool Polygon::get_cut(const Segment &s1, const Segment &s2, double s,
 
 void Polygon::push_back(const Point &p) {
     vertices.push_back(p);
+    invalidate_cache();
 }
@@ -22,22 +22,221 @@
 #pragma once
 
 #include "line.hpp"
+#include "kernels.hpp"
+#include "edgetree.hpp"
+#include "pointlocator.hpp"
+#include "triangulation.hpp"
 #include <string>
 #include <exception>
+#include <optional>
+#include <span>
+#include <mutex>
+#include <atomic>
+#include <array>
+#include <stdexcept>
+#include <initializer_list>
+
+namespace poly_private {
+struct Polygons;
+struct CutCandidate;
+};
 
 class Polygon {
+public:
+    /**
+     * @brief Counters filled by split to measure the candidate search.
+    */
+    struct SplitStatistics {
+        size_t evaluated_pairs{0};
+        size_t pruned_pairs{0};
+    };
+
+    /**
+     * @brief Number of times each cached structure has been built since the
+     * polygon was created.
+    */
+    struct CacheStatistics {
+        size_t edge_builds{0};
+        size_t vertex_array_builds{0};
+        size_t edge_tree_builds{0};
+        size_t point_locator_builds{0};
+        size_t property_builds{0};
+        size_t triangulation_builds{0};
+    };
+
+    /**
+     * @brief Method and bound used by simplify.
+    */
+    struct Simplification {
+        enum class Method {
+            None,
+            DouglasPeucker,
+            VisvalingamWhyatt
+        };
+
+        Method method{Method::None};
+        /**
+         * @brief Maximum distance between the polygon and its simplification
+         * for DouglasPeucker and maximum area error for VisvalingamWhyatt.
+        */
+        double tolerance{0};
+    };
+
 private:
     Points vertices;
 
+    /**
+     * @brief Precomputed data of the edge that goes from one vertex to the next.
+    */
+    struct Edge {
+        Segment segment;
+        Vector dir;
+        double inv_sq_length;
+        Point min;
+        Point max;
+    };
+
+    mutable std::mutex cache_mut;
+    mutable std::atomic<bool> edges_ready{false};
+    mutable std::vector<Edge> edges;
+    mutable std::atomic<bool> vertex_array_ready{false};
+    mutable poly_private::VertexArray vertex_array;
+    mutable std::atomic<bool> edge_tree_ready{false};
+    mutable poly_private::EdgeTree edge_tree;
+
+    /**
+     * @brief Polygons with fewer edges are scanned linearly, since the
+     * edge tree and the point locator do not pay off for them.
+    */
+    static constexpr size_t index_min_size{32};
+    mutable std::atomic<bool> point_locator_ready{false};
+    mutable poly_private::PointLocator point_locator;
+
+    /**
+     * @brief Properties of the whole polygon that are computed together.
+    */
+    struct Properties {
+        double square_signed;
+        bool clockwise;
+        Point min;
+        Point max;
+        Point center;
+    };
+    mutable std::atomic<bool> properties_ready{false};
+    mutable Properties properties;
+
+    /**
+     * @brief 1 or -1 if the polygon is convex and it turns counterclockwise
+     * or clockwise, and 0 if it is not convex.
+    */
+    mutable std::atomic<bool> convexity_ready{false};
+    mutable int convexity;
+    mutable std::atomic<bool> triangulation_ready{false};
+    mutable Triangulation triangulation;
+    mutable CacheStatistics cache_statistics;
+
+    /**
+     * @brief Returns the edge table, building it if the vertices have
+     * changed since the last call.
+    */
+    const std::vector<Edge> &get_edges(void) const;
+
+    /**
+     * @brief Returns the structure-of-arrays copy of the vertices, building
+     * it if the vertices have changed since the last call.
+    */
+    const poly_private::VertexArray &get_vertex_array(void) const;
+
+    /**
+     * @brief Returns the hierarchy of the edge bounding boxes, building it
+     * if the vertices have changed since the last call. It is empty if the
+     * polygon has fewer than index_min_size edges.
+    */
+    const poly_private::EdgeTree &get_edge_tree(void) const;
+
+    /**
+     * @brief Returns the grid that classifies the points as inside or
+     * outside, building it if the vertices have changed since the last
+     * call. It is empty for the polygons with fewer than
+     * index_min_size edges, which are scanned instead.
+    */
+    const poly_private::PointLocator &get_point_locator(void) const;
+
+    /**
+     * @brief Returns the area, orientation, bounding box and center of the
+     * polygon, computing them if the vertices have changed since the last
+     * call. The orientation is only valid with two or more vertices and
+     * the rest of properties with one or more.
+    */
+    const Properties &get_properties(void) const;
+
+    /**
+     * @brief Returns the value of convexity, computing it if the vertices
+     * have changed since the last call.
+    */
+    int get_convexity(void) const;
+
+    /**
+     * @brief Classifies the point with a binary search over the triangles
+     * that join the first vertex to the edges of a convex polygon. The
+     * points that are not clearly inside or outside are returned as
+     * Boundary, to be classified by the scans.
+    */
+    poly_private::PointLocator::Location locate_in_fan(const Point &point) const;
+
+    /**
+     * @brief Discards all the data derived from the vertices.
+    */
+    void invalidate_cache(void);
+
+    /**
+     * @brief Takes the vertices and the cached data of p, leaving it empty.
+    */
+    void take(Polygon &p);
+
+    /**
+     * @brief Returns the index of the edge nearest to the point and the
+     * nearest point of that edge.
+    */
+    int find_nearest_edge(const Point &point, Point &nearest_point) const;
+
+    /**
+     * @brief Finds the cut line between the segments s1 and s2. The
+     * decompositions of the region between both segments are built only
+     * when needed and are kept in forward and backward to be reused.
+    */
     static bool get_cut(const Segment &s1, const Segment &s2, double s,
-                const Polygon &poly1, const Polygon &poly2,
+                double poly1_square, double poly2_square,
+                std::optional<poly_private::Polygons> &forward,
+                std::optional<poly_private::Polygons> &backward,
                 Segment &cut);
 
+    /**
+     * @brief Fills poly1 and poly2 with the two parts of the clockwise
+     * polygon divided by the cut.
+    */
+    static void build_split(const Points &polygon, const poly_private::CutCandidate &cut,
+                            Polygon &poly1, Polygon &poly2);
+
+    /**
+     * @brief Returns a copy of the vertices in clockwise order.
+    */
+    Points get_clockwise_vertices(void) const;
+
+    /**
+     * @brief Shared implementation of split and split_parallel that
+     * distributes the edge pairs among the given number of threads.
+    */
+    void search_cut(double square, Polygon &poly1, Polygon &poly2, Segment &cut_line,
+                    unsigned int n_threads, SplitStatistics *statistics) const;
+
 public:
     Polygon();
     Polygon(const Polygon &p);
+    Polygon(Polygon &&p) noexcept;
 
     Polygon(const Points &p);
+    Polygon(Points &&p);
 
     class NotEnoughPointsException : public std::exception {
         std::string message{"The polygon has not enough vertices"};
@@ -57,6 +256,15 @@ public:
             const char *what() const noexcept override;
     };
 
+    class SelfIntersectionException : public std::exception {
+        std::string message{"The edges of the polygon cross each other"};
+        public:
+            SelfIntersectionException();
+            SelfIntersectionException(const std::string &message);
+            SelfIntersectionException(const char *message);
+            const char *what() const noexcept override;
+    };
+
     /**
      * @brief Returns the polygon area.
     */
@@ -75,12 +283,68 @@ public:
      * poly2: The resulting polygon with the specified area.
      * @param
      * cut_line: The line dividing the two polygons.
+     * @param
+     * statistics: If not null, it receives the number of edge pairs
+     * evaluated and discarded by their lower bound or, in a convex
+     * polygon, by their areas.
      * 
      * @returns
      * true: if it is possible.
      * false: if it is not possible.
     */
-    void split(double square, Polygon &poly1, Polygon &poly2, Segment &cut_line) const;
+    void split(double square, Polygon &poly1, Polygon &poly2, Segment &cut_line,
+               SplitStatistics *statistics=nullptr) const;
+
+    /**
+     * @brief Same as split, but the candidate cut lines are evaluated by a
+     * pool of threads. The result is identical to the one given by split.
+     *
+     * @param
+     * n_threads: The number of worker threads. If zero, the number of
+     * hardware threads is used.
+    */
+    void split_parallel(double square, Polygon &poly1, Polygon &poly2, Segment &cut_line,
+                        unsigned int n_threads=0, SplitStatistics *statistics=nullptr) const;
+
+    struct SplitResult;
+
+    /**
+     * @brief Same as calling split for each area, but the decomposition of
+     * every edge pair is built only once and shared by all the areas.
+     *
+     * @param
+     * areas: The areas of the resulting poly2 of each split.
+     *
+     * @returns
+     * One result per area, in the same order.
+     *
+     * @throws
+     * Polygon::CannotSplitException: if any of the areas cannot be split.
+    */
+    std::vector<SplitResult> split_many(std::span<const double> areas) const;
+
+    /**
+     * @brief Returns a polygon with a subset of the vertices, none of them
+     * farther than tolerance from the boundary of the result (Douglas-Peucker).
+     * The result keeps the orientation and does not intersect itself
+     * if the polygon does not.
+    */
+    Polygon simplify_douglas_peucker(double tolerance) const;
+
+    /**
+     * @brief Returns a polygon with a subset of the vertices, removing
+     * first the ones that enclose the smallest triangle with their neighbours
+     * (Visvalingam-Whyatt) while the sum of the areas of the removed
+     * triangles does not exceed max_area_error. The result keeps the
+     * orientation and does not intersect itself if the polygon does not.
+    */
+    Polygon simplify_visvalingam_whyatt(double max_area_error) const;
+
+    /**
+     * @brief Calls the simplification method given by parameters or returns
+     * a copy of the polygon if the method is None.
+    */
+    Polygon simplify(const Simplification &simplification) const;
 
     /**
      * @brief Returns the distance between the nearest point of the polygon
@@ -108,6 +372,22 @@ public:
     */
     Point find_center(void) const;
 
+    /**
+     * @brief Returns the lower left corner of the bounding box.
+     *
+     * @throws
+     * Polygon::NotEnoughPointsException: if the polygon contains no points.
+    */
+    Point find_min_corner(void) const;
+
+    /**
+     * @brief Returns the upper right corner of the bounding box.
+     *
+     * @throws
+     * Polygon::NotEnoughPointsException: if the polygon contains no points.
+    */
+    Point find_max_corner(void) const;
+
     /**
      * @brief Generates a new vertex in the polygon at the nearest point
      * between the passed by parameter and the edge of the polygon.
@@ -120,6 +400,19 @@ public:
     */
     bool is_point_inside(const Point &point) const;
 
+    /**
+     * @brief Same as calling is_point_inside for each point, but the edges
+     * are read once for a whole block of points.
+     *
+     * @param
+     * inside: Receives 1 for the points inside the polygon and 0 for the
+     * rest, in the same order as the points.
+     *
+     * @throws
+     * std::invalid_argument: if inside has fewer elements than points.
+    */
+    void contains(std::span<const Point> points, std::span<uint8_t> inside) const;
+
     /**
      * @brief Returns true if the segment passed by parameters is contained
      * within the edges of the polygon. 
@@ -136,7 +429,68 @@ public:
     */
     bool is_clockwise(void) const;
 
-    const Points get_vertices(void) const {
+    /**
+     * @brief Returns the pairs of edges that cross or touch each other,
+     * apart from consecutive edges meeting at their common vertex, found
+     * with a sweep line (Bentley-Ottmann). Each edge is identified by the
+     * index of its first vertex and repeated consecutive vertices are
+     * ignored. The polygon is simple if there are none. When several
+     * edges meet at the same point only some of their pairs may be given.
+    */
+    std::vector<std::pair<size_t, size_t>> find_crossings(void) const;
+
+    /**
+     * @brief Returns a copy of the polygon without repeated vertices and
+     * without the vertices aligned with their neighbours, with the vertices
+     * in the order that is_clockwise reports as clockwise.
+     *
+     * @throws
+     * Polygon::NotEnoughPointsException: if fewer than three vertices remain.
+     * @throws
+     * Polygon::SelfIntersectionException: if any edges cross each other.
+    */
+    Polygon normalize(void) const;
+
+    /**
+     * @brief Returns the triangles that make up the polygon, computing them
+     * if the vertices have changed since the last call. The result is valid
+     * until the polygon is modified and it is empty for polygons with fewer
+     * than three vertices.
+    */
+    const Triangulation &triangulate(void) const;
+
+    /**
+     * @brief Returns a point of the polygon given by three numbers between
+     * 0 and 1. The first one chooses the triangle, in proportion to its
+     * area, and the others the point inside it, so the points are
+     * uniformly distributed when the numbers are.
+     *
+     * @throws
+     * Polygon::NotEnoughPointsException: if the polygon has fewer than
+     * three vertices.
+    */
+    Point sample_point(double r1, double r2, double r3) const;
+
+    /**
+     * @brief Returns true if the polygon is simple and convex. Aligned
+     * vertices are allowed, but not repeated vertices.
+    */
+    bool is_convex(void) const;
+
+    /**
+     * @brief Returns how many times the cached data have been rebuilt.
+    */
+    CacheStatistics get_cache_statistics(void) const;
+
+    const Points &get_vertices(void) const {
+        return vertices;
+    }
+
+    /**
+     * @brief Returns a view of the vertices that is valid until the polygon
+     * is modified.
+    */
+    std::span<const Point> get_vertices_view(void) const {
         return vertices;
     }
 
@@ -155,14 +509,26 @@ public:
 
     Polygon &operator=(const Polygon &p) {
         vertices = p.vertices;
+        invalidate_cache();
         return *this;
     }
 
-    Point &operator[](size_t index) {
-        return vertices[index];
+    Polygon &operator=(Polygon &&p) noexcept {
+        if (this != &p)
+            take(p);
+        return *this;
+    }
+
+    /**
+     * @brief Replaces the vertex at the given index and clears the cached
+     * data, which reading a vertex with operator[] does not.
+    */
+    void set(size_t index, const Point &point) {
+        vertices[index] = point;
+        invalidate_cache();
     }
 
-    Point operator[](size_t index) const {
+    const Point &operator[](size_t index) const {
         return vertices[index];
     }
 
@@ -171,6 +537,7 @@ public:
     */
     void clear(void) {
         vertices.clear();
+        invalidate_cache();
     }
 
     /**
@@ -181,6 +548,87 @@ public:
     }
 };
 
+/**
+ * @brief Up to N vertices stored inside the object, for the small pieces
+ * that only need their vertices and their area. It has none of the locks
+ * and caches of Polygon, so it is cheap to build and copy.
+*/
+template <size_t N>
+class SmallPolygon {
+public:
+    constexpr SmallPolygon() {}
+
+    constexpr SmallPolygon(std::initializer_list<Point> vertices) {
+        for (const Point &vertex : vertices) {
+            push_back(vertex);
+        }
+    }
+
+    /**
+     * @throws
+     * std::length_error: if the polygon already has N vertices.
+    */
+    constexpr void push_back(const Point &vertex) {
+        if (count == N)
+            throw std::length_error{"The small polygon is full"};
+
+        vertices[count++] = vertex;
+    }
+
+    constexpr const Point &operator[](size_t index) const {
+        return vertices[index];
+    }
+
+    constexpr const Point *begin(void) const {
+        return vertices.data();
+    }
+
+    constexpr const Point *end(void) const {
+        return vertices.data() + count;
+    }
+
+    constexpr size_t size(void) const {
+        return count;
+    }
+
+    constexpr bool empty(void) const {
+        return count == 0;
+    }
+
+    constexpr void clear(void) {
+        count = 0;
+    }
+
+    constexpr double count_square(void) const {
+        return poly_private::count_square(*this);
+    }
+
+    constexpr Point find_center(void) const {
+        return poly_private::find_center(*this);
+    }
+
+    /**
+     * @brief Returns a Polygon with the same vertices.
+    */
+    Polygon to_polygon(void) const {
+        return Polygon{Points{begin(), end()}};
+    }
+
+private:
+    std::array<Point, N> vertices{};
+    size_t count{0};
+};
+
+/**
+ * @brief Result of splitting the polygon for one of the areas
+ * requested to split_many.
+*/
+struct Polygon::SplitResult {
+    Polygon poly1;
+    Polygon poly2;
+    Segment cut_line;
+};
+
 namespace poly_private {
 struct Polygons {
     Polygons(const Segment &s1, const Segment &s2);
@@ -188,9 +636,10 @@ struct Polygons {
 
     Line bisector;
 
-    Polygon left_triangle;
-    Polygon trapezoid;
-    Polygon right_triangle;
+    // The triangles get the vertices of both ends when both exist
+    SmallPolygon<6> left_triangle;
+    SmallPolygon<4> trapezoid;
+    SmallPolygon<6> right_triangle;
 
     bool p1_exist;
     bool p2_exist;
@@ -202,4 +651,87 @@ struct Polygons {
     double right_triangle_square;
     double total_square;
 };
+
+/**
+ * @brief Cumulative table of the shoelace terms of a polygon that answers
+ * the signed area of any closed sub-chain of vertices in constant time.
+*/
+struct SquarePrefix {
+    SquarePrefix(const Points &polygon);
+
+    /**
+     * @brief Returns the same as count_square_signed for the polygon formed
+     * by the vertices from first to last, both included, following the
+     * cyclic order of the original polygon.
+    */
+    double chain_square_signed(size_t first, size_t last) const;
+
+    const Points &polygon;
+    Point origin;
+    std::vector<double> prefix;
+
+    private:
+        double cross(const Point &p1, const Point &p2) const;
+};
+
+/**
+ * @brief Pair of edges of a polygon together with a lower bound of the
+ * length of any cut line joining them, which is the distance between
+ * both edges.
+*/
+struct EdgePair {
+    EdgePair(const Points &polygon, int i, int j);
+
+    /**
+     * @brief Returns false if no cut line joining the edges can have a
+     * square length lower than or equal to the one passed by parameters.
+    */
+    bool can_improve(double sq_length) const;
+
+    bool operator<(const EdgePair &other) const;
+
+    double bound;
+    int i;
+    int j;
+};
+
+/**
+ * @brief Returns the distance between the point and the nearest point of
+ * the segment from start to end.
+*/
+double point_segment_distance(const Point &point, const Point &start, const Point &end);
+
+/**
+ * @brief Returns every pair of edges of the polygon sorted by their
+ * lower bound.
+*/
+std::vector<EdgePair> get_sorted_edge_pairs(const Points &polygon);
+
+/**
+ * @brief Same as get_sorted_edge_pairs for a convex polygon, but only
+ * returns the pairs whose cut line can leave the given area on one side.
+ * The region between both edges of a pair is a quadrilateral, so a pair
+ * can only be cut if the area is between the areas of the chains left at
+ * both sides of that quadrilateral. Since those areas change monotonically
+ * with the edges, the pairs are found advancing the bounds of each edge.
+*/
+std::vector<EdgePair> get_convex_edge_pairs(const Points &polygon, const SquarePrefix &square_prefix,
+                                            double square);
+
+/**
+ * @brief Cut line found between the edges i and j.
+*/
+struct CutCandidate {
+    /**
+     * @brief Returns true if the cut is shorter than the other one or, having
+     * the same length, its edge pair comes first in (i, j) order.
+    */
+    bool is_better_than(const CutCandidate &other) const;
+
+    bool exists{false};
+    double sq_length{std::numeric_limits<double>::max()};
+    int i{0};
+    int j{0};
+    Segment line;
+};
 };
\ No newline at end of file
@@ -0,0 +1,149 @@
+/**
+ * The MIT License (MIT)
+ * Copyright (c) 2016 Grabarchuk Viktor
+ * Copyright (c) 2023 Pablo López Sedeño
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#include "predicates.hpp"
+#include "vector.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+/**
+ * @brief Sum of doubles stored without rounding as non-overlapping
+ * components of increasing magnitude, as described by Shewchuk in
+ * "Adaptive Precision Floating-Point Arithmetic and Fast Robust Geometric
+ * Predicates".
+*/
+class Expansion {
+    public:
+        /**
+         * @brief Adds the product of both values without rounding.
+        */
+        void add_product(double a, double b) {
+            double product{a * b};
+            add(std::fma(a, b, -product));
+            add(product);
+        }
+
+        /**
+         * @brief Returns the most significant component, which has the sign
+         * of the whole sum.
+        */
+        double estimate() const {
+            return (size == 0) ? 0 : components[size - 1];
+        }
+
+    private:
+        static constexpr size_t max_size{16};
+        double components[max_size];
+        size_t size{0};
+
+        void add(double value) {
+            double q{value};
+            size_t new_size{0};
+
+            for (size_t i = 0; i < size; ++i) {
+                double sum{q + components[i]};
+                double b_virtual{sum - q};
+                double a_virtual{sum - b_virtual};
+                double error{(q - a_virtual) + (components[i] - b_virtual)};
+                q = sum;
+
+                if (error != 0)
+                    components[new_size++] = error;
+            }
+
+            if (q != 0)
+                components[new_size++] = q;
+
+            size = new_size;
+        }
+};
+};
+
+double predicates::orient2d(const Point &a, const Point &b, const Point &c) {
+    double det_left{(a.x - c.x) * (b.y - c.y)};
+    double det_right{(a.y - c.y) * (b.x - c.x)};
+    double det{det_left - det_right};
+    double error_bound{orient2d_error_bound * (fabs(det_left) + fabs(det_right))};
+
+    if ((det > error_bound) or (-det > error_bound))
+        return det;
+
+    return orient2d_exact(a, b, c);
+}
+
+double predicates::orient2d_exact(const Point &a, const Point &b, const Point &c) {
+    Expansion det;
+    det.add_product(a.x, b.y);
+    det.add_product(-a.x, c.y);
+    det.add_product(-c.x, b.y);
+    det.add_product(-a.y, b.x);
+    det.add_product(a.y, c.x);
+    det.add_product(c.y, b.x);
+
+    return det.estimate();
+}
+
+double predicates::line_side(double a, double b, const Point &origin, const Point &point) {
+    double term_x{a * (point.x - origin.x)};
+    double term_y{b * (point.y - origin.y)};
+    double side{term_x + term_y};
+    double error_bound{4 * std::numeric_limits<double>::epsilon() * (fabs(term_x) + fabs(term_y))};
+
+    if ((side > error_bound) or (-side > error_bound))
+        return side;
+
+    Expansion exact_side;
+    exact_side.add_product(a, point.x);
+    exact_side.add_product(-a, origin.x);
+    exact_side.add_product(b, point.y);
+    exact_side.add_product(-b, origin.y);
+
+    return exact_side.estimate();
+}
+
+/**
+ * @brief Returns true if the point, aligned with start and end, lies
+ * between them.
+*/
+static bool is_between(const Point &start, const Point &end, const Point &point) {
+    return (std::min(start.x, end.x) <= point.x) and (point.x <= std::max(start.x, end.x)) and
+           (std::min(start.y, end.y) <= point.y) and (point.y <= std::max(start.y, end.y));
+}
+
+bool predicates::segments_touch(const Point &a, const Point &b, const Point &c, const Point &d) {
+    double o1{orient2d(a, b, c)};
+    double o2{orient2d(a, b, d)};
+    double o3{orient2d(c, d, a)};
+    double o4{orient2d(c, d, b)};
+
+    if ((((o1 > 0) and (o2 < 0)) or ((o1 < 0) and (o2 > 0))) and
+        (((o3 > 0) and (o4 < 0)) or ((o3 < 0) and (o4 > 0))))
+        return true;
+
+    return ((o1 == 0) and is_between(a, b, c)) or ((o2 == 0) and is_between(a, b, d)) or
+           ((o3 == 0) and is_between(c, d, a)) or ((o4 == 0) and is_between(c, d, b));
+}
+
+bool predicates::segments_fold(const Point &a, const Point &b, const Point &c) {
+    return (orient2d(a, b, c) == 0) and (Vector{b - a}.dot(Vector{c - b}) < 0);
+}
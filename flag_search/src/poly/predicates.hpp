@@ -0,0 +1,64 @@
+/**
+ * The MIT License (MIT)
+ * Copyright (c) 2016 Grabarchuk Viktor
+ * Copyright (c) 2023 Pablo López Sedeño
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#pragma once
+
+#include "point.hpp"
+
+namespace predicates {
+/**
+ * @brief Relative error bound of the floating point evaluation of orient2d.
+*/
+constexpr double orient2d_error_bound{(3.0 + 16.0 * std::numeric_limits<double>::epsilon() / 2) *
+                                      std::numeric_limits<double>::epsilon() / 2};
+
+/**
+ * @brief Returns a positive value if the points a, b and c are in
+ * counterclockwise order, a negative value if they are in clockwise order
+ * and zero if they are aligned. The sign is always exact: the determinant
+ * is evaluated in floating point and, only when the result is smaller than
+ * its error bound, again with exact expansion arithmetic.
+*/
+double orient2d(const Point &a, const Point &b, const Point &c);
+
+/**
+ * @brief Same as orient2d, but it always uses exact arithmetic.
+*/
+double orient2d_exact(const Point &a, const Point &b, const Point &c);
+
+/**
+ * @brief Returns a value with the exact sign of a * (point.x - origin.x) +
+ * b * (point.y - origin.y), which tells the side of the line with
+ * coefficients a and b passing through origin where the point is.
+*/
+double line_side(double a, double b, const Point &origin, const Point &point);
+
+/**
+ * @brief Returns true if the segments a-b and c-d share any point.
+*/
+bool segments_touch(const Point &a, const Point &b, const Point &c, const Point &d);
+
+/**
+ * @brief Returns true if the consecutive segments a-b and b-c go back over
+ * each other.
+*/
+bool segments_fold(const Point &a, const Point &b, const Point &c);
+};
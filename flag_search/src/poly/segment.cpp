@@ -20,6 +20,7 @@
 */
 
 #include "line.hpp"
+#include "predicates.hpp"
 
 #include <cmath>
 
@@ -27,10 +28,6 @@ Segment::Segment() {
     l = Line{};
 }
 
-Segment::Segment(const Segment &s) {
-    l = s.l;
-}
-
 Segment::Segment(const Line &l) {
     this->l = l;
 }
@@ -43,28 +40,28 @@ Segment::Segment(const Point &start, const Point &end) {
  * @brief It returns the start point of the segment
 */
 Point Segment::get_start() const {
-    return start;
+    return l.p1;
 }
 
 /**
  * @brief It returns the end point of the segment
 */
 Point Segment::get_end() const {
-    return end;
+    return l.p2;
 }
 
 /**
  * @brief It returns the length of the segment
 */
 double Segment::length() const {
-    return start.distance(end);
+    return l.p1.distance(l.p2);
 }
 
 /**
  * @brief It returns the square of the length of the segment
 */
 double Segment::square_length() const {
-    return start.square_distance(end);
+    return l.p1.square_distance(l.p2);
 }
 
 /**
@@ -72,7 +69,7 @@ double Segment::square_length() const {
  * the new end point and vice versa
 */
 Segment Segment::reverse() const {
-    return Segment{end, start};
+    return Segment{l.p2, l.p1};
 }
 
 inline bool inside(double v, double min, double max) {
@@ -97,8 +94,8 @@ inline double maximum(double a, double b) {
 */
 Point Segment::get_point_along(double t) const {
     Point p{l.get_point_along(t)};
-    Point min{minimum(start.x, end.x), minimum(start.y, end.y)};
-    Point max{maximum(start.x, end.x), maximum(start.y, end.y)};
+    Point min{minimum(l.p1.x, l.p2.x), minimum(l.p1.y, l.p2.y)};
+    Point max{maximum(l.p1.x, l.p2.x), maximum(l.p1.y, l.p2.y)};
     
     if (!inside(p.x, min.x, max.x) or (!inside(p.y, min.y, max.y))) {
         p = get_nearest_point(p);
@@ -121,20 +118,20 @@ double Segment::get_distance(const Point &point) const {
 */
 Point Segment::get_nearest_point(const Point &point) const {
     Vector dir{l.b, -l.a};
-    double u{Vector{point - start}.dot(dir) / dir.square_length()};
+    double u{Vector{point - l.p1}.dot(dir) / dir.square_length()};
     if (u < 0)
-        return start;
+        return l.p1;
     else if (u > 1)
-        return end;
+        return l.p2;
     else
-        return start + dir * u;
+        return l.p1 + dir * u;
 }
 
 /**
  * @brief Returns if the point is over, under or in the line
 */
 PointSide Segment::point_side(const Point &point) const {
-    double s{l.a * (point.x - start.x) + l.b * (point.y - start.y)};
+    double s{predicates::line_side(l.a, l.b, l.p1, point)};
     if (s > 0) {
         return PointSide::Above;
     } else if (s < 0) {
@@ -164,8 +161,11 @@ bool Segment::cross_line(const Line &line, Point &result) const {
     result.x = -det(line.c, line.b, l.c, l.b) / d;
     result.y = -det(line.a, line.c, l.a, l.c) / d;
 
-    return inside(result.x, minimum(start.x, end.x), maximum(start.x, end.x)) &&
-            inside(result.y, minimum(start.y, end.y), maximum(start.y, end.y));
+    // The segment meets the line unless both ends are strictly on the same side
+    double start_side{predicates::orient2d(line.p1, line.p2, l.p1)};
+    double end_side{predicates::orient2d(line.p1, line.p2, l.p2)};
+
+    return !(((start_side > 0) and (end_side > 0)) or ((start_side < 0) and (end_side < 0)));
 }
 
 /**
@@ -185,20 +185,11 @@ bool Segment::cross_line(const Segment &seg, Point &result) const {
     result.x = -det(l.c, l.b, seg.l.c, seg.l.b) / d;
     result.y = -det(l.a, l.c, seg.l.a, seg.l.c) / d;
 
-    return inside(result.x, minimum(start.x, end.x), maximum(start.x, end.x)) &&
-           inside(result.y, minimum(start.y, end.y), maximum(start.y, end.y)) &&
-           inside(result.x, minimum(seg.start.x, seg.end.x), maximum(seg.start.x, seg.end.x)) &&
-           inside(result.y, minimum(seg.start.y, seg.end.y), maximum(seg.start.y, seg.end.y));
+    return predicates::segments_touch(l.p1, l.p2, seg.l.p1, seg.l.p2);
 }
 
 bool Segment::operator==(const Segment &other) const {
-    return start == other.start and end == other.end;
-}
-
-Segment &Segment::operator=(const Segment &other) {
-    l = other.l;
-
-    return *this;
+    return l.p1 == other.l.p1 and l.p2 == other.l.p2;
 }
 
 /**
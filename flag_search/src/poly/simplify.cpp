@@ -0,0 +1,287 @@
+/**
+ * The MIT License (MIT)
+ * Copyright (c) 2023 Pablo López Sedeño
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#include "polygon.hpp"
+#include "predicates.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <queue>
+#include <stdexcept>
+#include <tuple>
+
+using namespace poly_private;
+
+/**
+ * @brief Returns twice the signed area of the ring given by the vertices,
+ * positive if they are in counterclockwise order.
+*/
+static double shoelace(const Points &vertices) {
+    double sum{0};
+    for (size_t i = 0; i < vertices.size(); i++) {
+        const Point &next{vertices[(i + 1) % vertices.size()]};
+        sum += vertices[i].x * next.y - next.x * vertices[i].y;
+    }
+
+    return sum;
+}
+
+/**
+ * @brief Returns the pairs of edges of the ring of kept vertices that touch
+ * each other, sharing more than their common vertex if they are consecutive.
+*/
+static std::vector<std::pair<size_t, size_t>> find_touching_edges(const Points &vertices,
+                                                                  const std::vector<size_t> &kept) {
+    size_t kept_size{kept.size()};
+    std::vector<size_t> order(kept_size);
+    for (size_t t = 0; t < kept_size; t++) {
+        order[t] = t;
+    }
+
+    auto start{[&](size_t t) -> const Point & { return vertices[kept[t]]; }};
+    auto end{[&](size_t t) -> const Point & { return vertices[kept[(t + 1) % kept_size]]; }};
+
+    std::sort(order.begin(), order.end(), [&](size_t t1, size_t t2) {
+        return std::min(start(t1).x, end(t1).x) < std::min(start(t2).x, end(t2).x);
+    });
+
+    std::vector<std::pair<size_t, size_t>> touching;
+    for (size_t u = 0; u < kept_size; u++) {
+        size_t t1{order[u]};
+        double max_x{std::max(start(t1).x, end(t1).x)};
+
+        for (size_t w = u + 1; w < kept_size; w++) {
+            size_t t2{order[w]};
+            if (std::min(start(t2).x, end(t2).x) > max_x)
+                break;
+
+            if ((t1 + 1) % kept_size == t2) {
+                if (predicates::segments_fold(start(t1), end(t1), end(t2)))
+                    touching.emplace_back(t1, t2);
+            } else if ((t2 + 1) % kept_size == t1) {
+                if (predicates::segments_fold(start(t2), end(t2), end(t1)))
+                    touching.emplace_back(t1, t2);
+            } else if (predicates::segments_touch(start(t1), end(t1), start(t2), end(t2))) {
+                touching.emplace_back(t1, t2);
+            }
+        }
+    }
+
+    return touching;
+}
+
+Polygon Polygon::simplify_douglas_peucker(double tolerance) const {
+    if (tolerance < 0)
+        throw std::invalid_argument{"The tolerance of a simplification cannot be negative"};
+
+    size_t polygon_size{vertices.size()};
+    if (polygon_size <= 3)
+        return *this;
+
+    // The chain between two kept vertices is refined at its farthest vertex
+    std::vector<bool> keep(polygon_size, false);
+    auto refine{[&](size_t first, size_t last) {
+        double max_distance{-1};
+        size_t farthest{first};
+        for (size_t i = first + 1; i < last; i++) {
+            double distance{point_segment_distance(vertices[i % polygon_size],
+                                                   vertices[first % polygon_size],
+                                                   vertices[last % polygon_size])};
+            if (distance > max_distance) {
+                max_distance = distance;
+                farthest = i;
+            }
+        }
+
+        return std::make_pair(farthest, max_distance);
+    }};
+
+    // The ring is opened at the first vertex and at the farthest one from it
+    size_t anchor{0};
+    double max_distance{0};
+    for (size_t i = 1; i < polygon_size; i++) {
+        double distance{vertices[0].distance(vertices[i])};
+        if (distance > max_distance) {
+            max_distance = distance;
+            anchor = i;
+        }
+    }
+    keep[0] = true;
+    keep[anchor] = true;
+
+    std::vector<std::pair<size_t, size_t>> pending{{0, anchor}, {anchor, polygon_size}};
+    while (!pending.empty()) {
+        auto [first, last]{pending.back()};
+        pending.pop_back();
+
+        auto [farthest, distance]{refine(first, last)};
+        if (distance > tolerance) {
+            keep[farthest % polygon_size] = true;
+            pending.emplace_back(first, farthest);
+            pending.emplace_back(farthest, last);
+        }
+    }
+
+    // A polygon needs three vertices, even if the third one is within the tolerance
+    if (std::count(keep.begin(), keep.end(), true) < 3) {
+        auto forward{refine(0, anchor)};
+        auto backward{refine(anchor, polygon_size)};
+        keep[(forward.second >= backward.second ? forward.first : backward.first) % polygon_size] = true;
+    }
+
+    // The chains of the edges that touch other edges are refined until none does
+    std::vector<size_t> kept;
+    bool refined{true};
+    while (refined) {
+        kept.clear();
+        for (size_t i = 0; i < polygon_size; i++) {
+            if (keep[i])
+                kept.push_back(i);
+        }
+
+        refined = false;
+        for (auto [t1, t2] : find_touching_edges(vertices, kept)) {
+            for (size_t t : {t1, t2}) {
+                size_t first{kept[t]};
+                size_t last{t + 1 < kept.size() ? kept[t + 1] : kept[0] + polygon_size};
+                if (last - first > 1) {
+                    keep[refine(first, last).first % polygon_size] = true;
+                    refined = true;
+                }
+            }
+        }
+    }
+
+    Points simplified;
+    simplified.reserve(kept.size());
+    for (size_t i : kept) {
+        simplified.push_back(vertices[i]);
+    }
+
+    double original_shoelace{shoelace(vertices)};
+    double simplified_shoelace{shoelace(simplified)};
+    if ((simplified_shoelace > 0) != (original_shoelace > 0) or simplified_shoelace == 0)
+        return *this;
+
+    return Polygon{std::move(simplified)};
+}
+
+Polygon Polygon::simplify_visvalingam_whyatt(double max_area_error) const {
+    if (max_area_error < 0)
+        throw std::invalid_argument{"The area error of a simplification cannot be negative"};
+
+    size_t polygon_size{vertices.size()};
+    if (polygon_size <= 3)
+        return *this;
+
+    std::vector<size_t> prev(polygon_size);
+    std::vector<size_t> next(polygon_size);
+    std::vector<size_t> version(polygon_size, 0);
+    std::vector<bool> removed(polygon_size, false);
+    for (size_t i = 0; i < polygon_size; i++) {
+        prev[i] = (i + polygon_size - 1) % polygon_size;
+        next[i] = (i + 1) % polygon_size;
+    }
+
+    // Twice the signed area of the triangle each vertex encloses with its neighbours
+    auto triangle{[&](size_t i) {
+        return predicates::orient2d(vertices[prev[i]], vertices[i], vertices[next[i]]);
+    }};
+
+    using Candidate = std::tuple<double, size_t, size_t>;
+    std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate>> candidates;
+    for (size_t i = 0; i < polygon_size; i++) {
+        candidates.emplace(fabs(triangle(i)) / 2, i, 0);
+    }
+
+    double ring_shoelace{shoelace(vertices)};
+
+    // The new edge cannot touch the rest of the ring
+    auto can_remove{[&](size_t i) {
+        const Point &p{vertices[prev[i]]};
+        const Point &q{vertices[next[i]]};
+
+        if (predicates::segments_fold(vertices[prev[prev[i]]], p, q) or
+            predicates::segments_fold(p, q, vertices[next[next[i]]]))
+            return false;
+
+        Point min{std::min(p.x, q.x), std::min(p.y, q.y)};
+        Point max{std::max(p.x, q.x), std::max(p.y, q.y)};
+        for (size_t j = next[next[next[i]]]; j != prev[i]; j = next[j]) {
+            const Point &start{vertices[prev[j]]};
+            const Point &end{vertices[j]};
+            if (std::max(start.x, end.x) < min.x or std::min(start.x, end.x) > max.x or
+                std::max(start.y, end.y) < min.y or std::min(start.y, end.y) > max.y)
+                continue;
+
+            if (predicates::segments_touch(p, q, start, end))
+                return false;
+        }
+
+        return true;
+    }};
+
+    size_t remaining{polygon_size};
+    double area_error{0};
+    while (remaining > 3 and !candidates.empty()) {
+        auto [area, i, candidate_version]{candidates.top()};
+        if (area_error + area > max_area_error)
+            break;
+        candidates.pop();
+
+        if (removed[i] or candidate_version != version[i])
+            continue;
+
+        double new_shoelace{ring_shoelace - triangle(i)};
+        if ((new_shoelace > 0) != (ring_shoelace > 0) or new_shoelace == 0 or !can_remove(i))
+            continue;
+
+        removed[i] = true;
+        remaining--;
+        area_error += area;
+        ring_shoelace = new_shoelace;
+        next[prev[i]] = next[i];
+        prev[next[i]] = prev[i];
+
+        for (size_t neighbour : {prev[i], next[i]}) {
+            candidates.emplace(fabs(triangle(neighbour)) / 2, neighbour, ++version[neighbour]);
+        }
+    }
+
+    Points simplified;
+    simplified.reserve(remaining);
+    for (size_t i = 0; i < polygon_size; i++) {
+        if (!removed[i])
+            simplified.push_back(vertices[i]);
+    }
+
+    return Polygon{std::move(simplified)};
+}
+
+Polygon Polygon::simplify(const Simplification &simplification) const {
+    switch (simplification.method) {
+        case Simplification::Method::DouglasPeucker:
+            return simplify_douglas_peucker(simplification.tolerance);
+        case Simplification::Method::VisvalingamWhyatt:
+            return simplify_visvalingam_whyatt(simplification.tolerance);
+        default:
+            return *this;
+    }
+}
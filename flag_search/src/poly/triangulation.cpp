@@ -0,0 +1,471 @@
+/**
+ * The MIT License (MIT)
+ * Copyright (c) 2023 Pablo López Sedeño
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+
+#include "triangulation.hpp"
+#include "predicates.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <set>
+#include <stdexcept>
+
+namespace {
+/**
+ * @brief Order of the sweep that goes down the polygon: higher points
+ * first and, at the same height, the ones on the left.
+*/
+bool is_above(const Point &p, const Point &q) {
+    return (p.y > q.y) or ((p.y == q.y) and (p.x < q.x));
+}
+
+/**
+ * @brief Order of the edges crossed by the sweep line from left to right.
+ * Each edge is identified by the position of its first vertex in the
+ * polygon, and it can also be compared with a point of the sweep line.
+*/
+class EdgeOrder {
+    public:
+        using is_transparent = void;
+
+        EdgeOrder(const Points &vertices, const std::vector<size_t> &polygon)
+            : vertices{vertices}, polygon{polygon} {}
+
+        bool operator()(size_t edge1, size_t edge2) const {
+            if (edge1 == edge2)
+                return false;
+
+            // The upper vertex of the edge that began later is tested against the other one
+            if (!is_above(upper(edge2), upper(edge1)))
+                return side(edge1, upper(edge2), lower(edge2)) > 0;
+            else
+                return side(edge2, upper(edge1), lower(edge1)) < 0;
+        }
+
+        bool operator()(size_t edge, const Point &point) const {
+            return predicates::orient2d(upper(edge), lower(edge), point) > 0;
+        }
+
+        bool operator()(const Point &point, size_t edge) const {
+            return predicates::orient2d(upper(edge), lower(edge), point) < 0;
+        }
+
+    private:
+        const Points &vertices;
+        const std::vector<size_t> &polygon;
+
+        const Point &start(size_t edge) const {
+            return vertices[polygon[edge]];
+        }
+
+        const Point &end(size_t edge) const {
+            return vertices[polygon[(edge + 1) % polygon.size()]];
+        }
+
+        const Point &upper(size_t edge) const {
+            return is_above(start(edge), end(edge)) ? start(edge) : end(edge);
+        }
+
+        const Point &lower(size_t edge) const {
+            return is_above(start(edge), end(edge)) ? end(edge) : start(edge);
+        }
+
+        /**
+         * @brief Returns a positive value if the edge is on the left of the
+         * point, using the second point for the points on the edge.
+        */
+        double side(size_t edge, const Point &point, const Point &tie_point) const {
+            double result{predicates::orient2d(upper(edge), lower(edge), point)};
+            if (result == 0)
+                result = predicates::orient2d(upper(edge), lower(edge), tie_point);
+
+            return result;
+        }
+};
+
+/**
+ * @brief Returns true if the direction from origin to p comes before the
+ * direction from origin to q, turning counterclockwise from the positive
+ * x axis.
+*/
+bool is_before(const Point &origin, const Point &p, const Point &q) {
+    auto half{[&](const Point &point) {
+        return (point.y < origin.y) or ((point.y == origin.y) and (point.x < origin.x));
+    }};
+
+    if (half(p) != half(q))
+        return !half(p);
+
+    return predicates::orient2d(origin, p, q) > 0;
+}
+};
+
+Triangulation::Triangulation() {}
+
+Triangulation::Triangulation(const Points &vertices) {
+    size_t n{vertices.size()};
+    if (n < 3)
+        return;
+
+    double doubled_area{0};
+    for (size_t i = 0; i < n; ++i) {
+        const Point &next{vertices[(i + 1) % n]};
+        doubled_area += vertices[i].x * next.y - next.x * vertices[i].y;
+    }
+
+    // The triangulation works on the vertices in counterclockwise order,
+    // without the repeated ones
+    std::vector<size_t> polygon;
+    polygon.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        if (!(vertices[i] == vertices[(i + 1) % n]))
+            polygon.push_back(i);
+    }
+    if (doubled_area < 0)
+        std::reverse(polygon.begin(), polygon.end());
+
+    n = polygon.size();
+    if (n < 3)
+        return;
+
+    triangles.reserve(n - 2);
+    if (n <= ear_clipping_max_size) {
+        clip_ears(vertices, polygon);
+    } else {
+        std::vector<std::pair<size_t, size_t>> diagonals{find_monotone_diagonals(vertices, polygon)};
+
+        // Neighbours of each position, sorted counterclockwise around it
+        std::vector<std::vector<size_t>> neighbours(n);
+        for (size_t k = 0; k < n; ++k) {
+            neighbours[k].push_back((k + n - 1) % n);
+            neighbours[k].push_back((k + 1) % n);
+        }
+        for (auto [k1, k2] : diagonals) {
+            neighbours[k1].push_back(k2);
+            neighbours[k2].push_back(k1);
+        }
+        for (size_t k = 0; k < n; ++k) {
+            const Point &origin{vertices[polygon[k]]};
+            std::sort(neighbours[k].begin(), neighbours[k].end(), [&](size_t k1, size_t k2) {
+                return is_before(origin, vertices[polygon[k1]], vertices[polygon[k2]]);
+            });
+        }
+
+        // Each monotone polygon is the face on the left of a cycle of
+        // edges, which turns as much as possible to the left at each vertex
+        std::vector<std::vector<bool>> visited(n);
+        for (size_t k = 0; k < n; ++k)
+            visited[k].assign(neighbours[k].size(), false);
+
+        auto slot{[&](size_t from, size_t to) {
+            return static_cast<size_t>(std::find(neighbours[from].begin(), neighbours[from].end(), to) -
+                                       neighbours[from].begin());
+        }};
+
+        std::vector<size_t> face;
+        for (size_t k = 0; k < n; ++k) {
+            for (size_t s = 0; s < neighbours[k].size(); ++s) {
+                // The edges to the previous vertex have the outside on their left
+                if (visited[k][s] or (neighbours[k][s] == (k + n - 1) % n))
+                    continue;
+
+                face.clear();
+                size_t from{k};
+                size_t to{neighbours[k][s]};
+                while (!visited[from][slot(from, to)] and (face.size() < n)) {
+                    visited[from][slot(from, to)] = true;
+                    face.push_back(polygon[from]);
+
+                    const std::vector<size_t> &around{neighbours[to]};
+                    size_t back{slot(to, from)};
+                    size_t next{around[(back + around.size() - 1) % around.size()]};
+                    from = to;
+                    to = next;
+                }
+
+                triangulate_monotone(vertices, face);
+            }
+        }
+    }
+
+    // The triangles follow the orientation of the polygon
+    cumulative_area.reserve(triangles.size());
+    double area{0};
+    for (Triangle &triangle : triangles) {
+        const Point &a{vertices[triangle[0]]};
+        const Point &b{vertices[triangle[1]]};
+        const Point &c{vertices[triangle[2]]};
+        area += std::fabs((b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x)) / 2;
+        cumulative_area.push_back(area);
+
+        if (doubled_area < 0)
+            std::swap(triangle[1], triangle[2]);
+    }
+}
+
+size_t Triangulation::find_triangle(double area) const {
+    if (cumulative_area.empty())
+        throw std::out_of_range{"The triangulation has no triangles"};
+
+    auto it{std::lower_bound(cumulative_area.begin(), cumulative_area.end(), area)};
+    if (it == cumulative_area.end())
+        return cumulative_area.size() - 1;
+
+    return static_cast<size_t>(it - cumulative_area.begin());
+}
+
+void Triangulation::clip_ears(const Points &vertices, const std::vector<size_t> &polygon) {
+    size_t n{polygon.size()};
+    std::vector<size_t> prev(n);
+    std::vector<size_t> next(n);
+    for (size_t k = 0; k < n; ++k) {
+        prev[k] = (k + n - 1) % n;
+        next[k] = (k + 1) % n;
+    }
+
+    auto point{[&](size_t k) -> const Point & {
+        return vertices[polygon[k]];
+    }};
+
+    auto is_convex{[&](size_t k) {
+        return predicates::orient2d(point(prev[k]), point(k), point(next[k])) > 0;
+    }};
+
+    // Only a reflex vertex can be inside the triangle of a convex vertex
+    // if there are no vertices inside it
+    auto is_ear{[&](size_t k) {
+        if (!is_convex(k))
+            return false;
+
+        const Point &a{point(prev[k])};
+        const Point &b{point(k)};
+        const Point &c{point(next[k])};
+        for (size_t j = next[next[k]]; j != prev[k]; j = next[j]) {
+            const Point &p{point(j)};
+            if (is_convex(j) or (p == a) or (p == c))
+                continue;
+
+            if ((predicates::orient2d(a, b, p) >= 0) and (predicates::orient2d(b, c, p) >= 0) and
+                (predicates::orient2d(c, a, p) >= 0))
+                return false;
+        }
+
+        return true;
+    }};
+
+    size_t remaining{n};
+    size_t k{0};
+    size_t misses{0};
+    while (remaining > 3) {
+        // A polygon that is not simple may have no ears, so one is forced
+        if (is_ear(k) or (misses > remaining)) {
+            add_triangle(vertices, polygon[prev[k]], polygon[k], polygon[next[k]]);
+            next[prev[k]] = next[k];
+            prev[next[k]] = prev[k];
+            k = prev[k];
+            --remaining;
+            misses = 0;
+        } else {
+            k = next[k];
+            ++misses;
+        }
+    }
+
+    add_triangle(vertices, polygon[prev[k]], polygon[k], polygon[next[k]]);
+}
+
+std::vector<std::pair<size_t, size_t>> Triangulation::find_monotone_diagonals(const Points &vertices,
+                                                                              const std::vector<size_t> &polygon) {
+    enum class Type {
+        Start,
+        Split,
+        End,
+        Merge,
+        LeftChain,
+        RightChain
+    };
+
+    size_t n{polygon.size()};
+    auto point{[&](size_t k) -> const Point & {
+        return vertices[polygon[k]];
+    }};
+
+    std::vector<Type> types(n);
+    for (size_t k = 0; k < n; ++k) {
+        const Point &prev{point((k + n - 1) % n)};
+        const Point &next{point((k + 1) % n)};
+        bool convex{predicates::orient2d(prev, point(k), next) > 0};
+
+        if (is_above(point(k), prev) and is_above(point(k), next))
+            types[k] = convex ? Type::Start : Type::Split;
+        else if (is_above(prev, point(k)) and is_above(next, point(k)))
+            types[k] = convex ? Type::End : Type::Merge;
+        else if (is_above(prev, point(k)))
+            types[k] = Type::LeftChain;
+        else
+            types[k] = Type::RightChain;
+    }
+
+    std::vector<size_t> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](size_t k1, size_t k2) {
+        return is_above(point(k1), point(k2));
+    });
+
+    // The edges with the inside of the polygon on their right, crossed by
+    // the sweep line, with the lowest vertex visited above each of them
+    using Status = std::set<size_t, EdgeOrder>;
+    Status status{EdgeOrder{vertices, polygon}};
+    std::vector<Status::iterator> positions(n, status.end());
+    std::vector<size_t> helpers(n);
+    std::vector<std::pair<size_t, size_t>> diagonals;
+
+    // An edge that overlaps another one is left out, which only happens if
+    // the polygon is not simple
+    auto insert_edge{[&](size_t k) {
+        auto [it, inserted]{status.insert(k)};
+        positions[k] = inserted ? it : status.end();
+        helpers[k] = k;
+    }};
+
+    auto remove_edge{[&](size_t edge, size_t k) {
+        if (positions[edge] == status.end())
+            return;
+
+        if (types[helpers[edge]] == Type::Merge)
+            diagonals.emplace_back(k, helpers[edge]);
+        status.erase(positions[edge]);
+        positions[edge] = status.end();
+    }};
+
+    auto update_left_edge{[&](size_t k) {
+        auto it{status.lower_bound(point(k))};
+        if (it == status.begin())
+            return;
+
+        size_t edge{*std::prev(it)};
+        if ((types[k] == Type::Split) or (types[helpers[edge]] == Type::Merge))
+            diagonals.emplace_back(k, helpers[edge]);
+        helpers[edge] = k;
+    }};
+
+    for (size_t k : order) {
+        size_t prev_edge{(k + n - 1) % n};
+        switch (types[k]) {
+            case Type::Start:
+                insert_edge(k);
+                break;
+            case Type::Split:
+                update_left_edge(k);
+                insert_edge(k);
+                break;
+            case Type::End:
+                remove_edge(prev_edge, k);
+                break;
+            case Type::Merge:
+                remove_edge(prev_edge, k);
+                update_left_edge(k);
+                break;
+            case Type::LeftChain:
+                remove_edge(prev_edge, k);
+                insert_edge(k);
+                break;
+            case Type::RightChain:
+                update_left_edge(k);
+                break;
+        }
+    }
+
+    return diagonals;
+}
+
+void Triangulation::triangulate_monotone(const Points &vertices, const std::vector<size_t> &polygon) {
+    size_t n{polygon.size()};
+    if (n < 3)
+        return;
+
+    auto above{[&](size_t k1, size_t k2) {
+        return is_above(vertices[polygon[k1]], vertices[polygon[k2]]);
+    }};
+
+    std::vector<size_t> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), above);
+
+    // Going counterclockwise from the top, the left chain goes down to the bottom
+    std::vector<bool> is_left(n, false);
+    for (size_t k = order.front(); k != order.back(); k = (k + 1) % n)
+        is_left[k] = true;
+
+    auto point{[&](size_t k) -> const Point & {
+        return vertices[polygon[k]];
+    }};
+
+    auto add{[&](size_t k1, size_t k2, size_t k3) {
+        add_triangle(vertices, polygon[k1], polygon[k2], polygon[k3]);
+    }};
+
+    std::vector<size_t> stack{order[0], order[1]};
+    for (size_t j = 2; j + 1 < n; ++j) {
+        size_t k{order[j]};
+
+        if (is_left[k] != is_left[stack.back()]) {
+            // The vertex sees all the vertices in the stack, on the other chain
+            while (stack.size() > 1) {
+                size_t top{stack.back()};
+                stack.pop_back();
+                add(k, top, stack.back());
+            }
+            stack.clear();
+            stack.push_back(order[j - 1]);
+            stack.push_back(k);
+        } else {
+            size_t last{stack.back()};
+            stack.pop_back();
+            while (!stack.empty()) {
+                double turn{is_left[k] ? predicates::orient2d(point(stack.back()), point(last), point(k))
+                                       : predicates::orient2d(point(k), point(last), point(stack.back()))};
+                if (turn <= 0)
+                    break;
+
+                add(k, last, stack.back());
+                last = stack.back();
+                stack.pop_back();
+            }
+            stack.push_back(last);
+            stack.push_back(k);
+        }
+    }
+
+    size_t bottom{order.back()};
+    while (stack.size() > 1) {
+        size_t top{stack.back()};
+        stack.pop_back();
+        add(bottom, top, stack.back());
+    }
+}
+
+void Triangulation::add_triangle(const Points &vertices, size_t a, size_t b, size_t c) {
+    if (predicates::orient2d(vertices[a], vertices[b], vertices[c]) < 0)
+        std::swap(b, c);
+
+    triangles.push_back(Triangle{a, b, c});
+}
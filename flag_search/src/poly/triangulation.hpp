@@ -0,0 +1,121 @@
+/**
+ * The MIT License (MIT)
+ * Copyright (c) 2023 Pablo López Sedeño
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+
+#pragma once
+
+#include "point.hpp"
+#include <array>
+#include <vector>
+
+/**
+ * @brief Division of a simple polygon into triangles, with the accumulated
+ * area of the triangles so the triangle where a given area is reached is
+ * found with a binary search.
+*/
+class Triangulation {
+    public:
+        /**
+         * @brief Indices of the vertices of a triangle, in the same order as
+         * the polygon.
+        */
+        using Triangle = std::array<size_t, 3>;
+
+        Triangulation();
+
+        /**
+         * @brief Triangulates the simple polygon with the given vertices.
+         * Small polygons are triangulated by ear clipping and the rest
+         * are first divided into y-monotone polygons. A vertex equal to
+         * the next one is skipped, so it gives no triangle.
+        */
+        explicit Triangulation(const Points &vertices);
+
+        const std::vector<Triangle> &get_triangles() const {
+            return triangles;
+        }
+
+        /**
+         * @brief Returns the sum of the areas of the first triangles, up to
+         * the one with the given index, included.
+        */
+        double get_cumulative_area(size_t index) const {
+            return cumulative_area[index];
+        }
+
+        /**
+         * @brief Returns the area of all the triangles.
+        */
+        double get_area() const {
+            return cumulative_area.empty() ? 0 : cumulative_area.back();
+        }
+
+        /**
+         * @brief Returns the index of the triangle where the accumulated
+         * area reaches the given one. Areas out of range give the first or
+         * the last triangle.
+         *
+         * @throws
+         * std::out_of_range: if there are no triangles.
+        */
+        size_t find_triangle(double area) const;
+
+        size_t size() const {
+            return triangles.size();
+        }
+
+        bool empty() const {
+            return triangles.empty();
+        }
+
+    private:
+        /**
+         * @brief Polygons with more vertices are divided into monotone
+         * polygons instead of being clipped ear by ear.
+        */
+        static constexpr size_t ear_clipping_max_size{64};
+
+        std::vector<Triangle> triangles;
+        std::vector<double> cumulative_area;
+
+        /**
+         * @brief Adds the triangles of the polygon given by the indices of
+         * its vertices in counterclockwise order.
+        */
+        void clip_ears(const Points &vertices, const std::vector<size_t> &polygon);
+
+        /**
+         * @brief Returns the diagonals that divide the counterclockwise polygon
+         * into y-monotone polygons.
+        */
+        static std::vector<std::pair<size_t, size_t>> find_monotone_diagonals(const Points &vertices,
+                                                                             const std::vector<size_t> &polygon);
+
+        /**
+         * @brief Adds the triangles of the y-monotone polygon given by the
+         * indices of its vertices in counterclockwise order.
+        */
+        void triangulate_monotone(const Points &vertices, const std::vector<size_t> &polygon);
+
+        /**
+         * @brief Adds a triangle, with its vertices in counterclockwise order.
+        */
+        void add_triangle(const Points &vertices, size_t a, size_t b, size_t c);
+};
@@ -0,0 +1,332 @@
+/**
+ * The MIT License (MIT)
+ * Copyright (c) 2023 Pablo López Sedeño
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+
+#include "polygon.hpp"
+#include "predicates.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <set>
+#include <sstream>
+
+namespace {
+/**
+ * @brief Edge of the polygon with its ends ordered from left to right.
+*/
+struct SweepEdge {
+    Point left;
+    Point right;
+};
+
+bool is_before(const Point &p, const Point &q) {
+    return (p.x < q.x) or ((p.x == q.x) and (p.y < q.y));
+}
+
+/**
+ * @brief Order of the edges crossed by the vertical sweep line from bottom
+ * to top. The edges below the sweep point come first, then the edges that
+ * pass through it ordered as they are just after it, and then the edges
+ * above it. Every test is an exact orient2d, so the order is a strict weak
+ * ordering at each sweep point. The status holds slots instead of edges,
+ * so two crossing edges are swapped by exchanging the edges of their slots.
+*/
+class SweepOrder {
+    public:
+        SweepOrder(const std::vector<SweepEdge> &edges, const std::vector<size_t> &slot_edges, const Point &sweep)
+            : edges{edges}, slot_edges{slot_edges}, sweep{sweep} {}
+
+        bool operator()(size_t slot1, size_t slot2) const {
+            size_t edge1{slot_edges[slot1]};
+            size_t edge2{slot_edges[slot2]};
+            if (edge1 == edge2)
+                return false;
+
+            const SweepEdge &a{edges[edge1]};
+            const SweepEdge &b{edges[edge2]};
+            int side1{side(a)};
+            int side2{side(b)};
+            if (side1 != side2)
+                return side1 < side2;
+
+            // Both edges leave the sweep point towards their right ends
+            double turn{(side1 == 0) ? predicates::orient2d(sweep, a.right, b.right) : height(a, b)};
+            if (turn != 0)
+                return turn > 0;
+
+            return edge1 < edge2;
+        }
+
+    private:
+        const std::vector<SweepEdge> &edges;
+        const std::vector<size_t> &slot_edges;
+        const Point &sweep;
+
+        /**
+         * @brief Returns -1 if the edge passes below the sweep point, 0 if
+         * it passes through it and 1 if it passes above it.
+        */
+        int side(const SweepEdge &edge) const {
+            double orientation{predicates::orient2d(edge.left, edge.right, sweep)};
+            return (orientation > 0) ? -1 : ((orientation < 0) ? 1 : 0);
+        }
+
+        /**
+         * @brief Returns a positive value if the edge a is below the edge b
+         * on the same side of the sweep point. The edge that begins later
+         * is tested against the other one, which spans its left end.
+        */
+        static double height(const SweepEdge &a, const SweepEdge &b) {
+            if (is_before(a.left, b.left)) {
+                double orientation{predicates::orient2d(a.left, a.right, b.left)};
+                return (orientation != 0) ? orientation : predicates::orient2d(a.left, a.right, b.right);
+            }
+
+            double orientation{predicates::orient2d(b.left, b.right, a.left)};
+            return -((orientation != 0) ? orientation : predicates::orient2d(b.left, b.right, a.right));
+        }
+};
+
+/**
+ * @brief Point where the sweep line stops. At the same point, the edges
+ * that end are removed first, then the crossing edges are swapped and at
+ * last the edges that begin are inserted.
+*/
+struct SweepEvent {
+    enum class Type {
+        Remove,
+        Swap,
+        Insert
+    };
+
+    Point point;
+    Type type;
+    size_t edge1;
+    size_t edge2;
+
+    bool operator<(const SweepEvent &event) const {
+        if (point.x != event.point.x)
+            return point.x < event.point.x;
+        if (point.y != event.point.y)
+            return point.y < event.point.y;
+        if (type != event.type)
+            return type < event.type;
+        if (edge1 != event.edge1)
+            return edge1 < event.edge1;
+        return edge2 < event.edge2;
+    }
+};
+
+};
+
+std::vector<std::pair<size_t, size_t>> Polygon::find_crossings(void) const {
+    // The edges join the vertices that are not repeated by the next one
+    size_t polygon_size{vertices.size()};
+    std::vector<size_t> kept;
+    kept.reserve(polygon_size);
+    for (size_t i = 0; i < polygon_size; ++i) {
+        if (!(vertices[i] == vertices[(i + 1) % polygon_size]))
+            kept.push_back(i);
+    }
+
+    size_t n{kept.size()};
+    if (n < 2)
+        return {};
+    std::set<std::pair<size_t, size_t>> crossings;
+
+    std::vector<SweepEdge> edges(n);
+    std::set<SweepEvent> events;
+    for (size_t e = 0; e < n; ++e) {
+        const Point &start{vertices[kept[e]]};
+        const Point &end{vertices[kept[(e + 1) % n]]};
+        edges[e] = is_before(start, end) ? SweepEdge{start, end} : SweepEdge{end, start};
+        events.insert(SweepEvent{edges[e].left, SweepEvent::Type::Insert, e, e});
+        events.insert(SweepEvent{edges[e].right, SweepEvent::Type::Remove, e, e});
+    }
+
+    // Each edge is inserted in the slot with its index, and two crossing
+    // edges exchange their slots
+    Point sweep{edges[0].left};
+    std::vector<size_t> slot_edges(n);
+    std::vector<size_t> edge_slots(n);
+    for (size_t e = 0; e < n; ++e) {
+        slot_edges[e] = e;
+        edge_slots[e] = e;
+    }
+
+    using Status = std::set<size_t, SweepOrder>;
+    Status status{SweepOrder{edges, slot_edges, sweep}};
+    std::vector<Status::iterator> positions(n, status.end());
+
+    // Two edges cross at most once, so they are swapped at most once
+    std::set<std::pair<size_t, size_t>> scheduled;
+
+    // Checks two edges that have become neighbours in the status, the
+    // first one below the second one
+    auto check{[&](size_t edge1, size_t edge2) {
+        const SweepEdge &a{edges[edge1]};
+        const SweepEdge &b{edges[edge2]};
+
+        if ((edge2 == (edge1 + 1) % n) or (edge1 == (edge2 + 1) % n)) {
+            size_t first{(edge2 == (edge1 + 1) % n) ? edge1 : edge2};
+            const Point &start{vertices[kept[first]]};
+            const Point &middle{vertices[kept[(first + 1) % n]]};
+            const Point &end{vertices[kept[(first + 2) % n]]};
+            if ((n == 2) or predicates::segments_fold(start, middle, end))
+                crossings.emplace(std::min(kept[edge1], kept[edge2]), std::max(kept[edge1], kept[edge2]));
+            return;
+        }
+
+        if (!predicates::segments_touch(a.left, a.right, b.left, b.right))
+            return;
+
+        crossings.emplace(std::min(kept[edge1], kept[edge2]), std::max(kept[edge1], kept[edge2]));
+
+        // The edges that cross change their order at the crossing point,
+        // which is kept after the sweep line despite the rounding errors
+        double o1{predicates::orient2d(a.left, a.right, b.left)};
+        double o2{predicates::orient2d(a.left, a.right, b.right)};
+        if ((o1 == 0) or (o2 == 0) or ((o1 > 0) == (o2 > 0)))
+            return;
+
+        // The edges only swap when the upper one ends below the lower one,
+        // the status may already have them in that order near the crossing
+        if (o2 > 0)
+            return;
+
+        Vector dir_a{a.right - a.left};
+        Vector dir_b{b.right - b.left};
+
+        std::pair<size_t, size_t> pair{std::min(edge1, edge2), std::max(edge1, edge2)};
+        if (!scheduled.insert(pair).second)
+            return;
+
+        Vector offset{b.left - a.left};
+        double t{(offset.x * dir_b.y - offset.y * dir_b.x) / (dir_a.x * dir_b.y - dir_a.y * dir_b.x)};
+        Point crossing{a.left + dir_a * std::clamp(t, 0.0, 1.0)};
+        if (is_before(crossing, sweep))
+            crossing = sweep;
+        events.insert(SweepEvent{crossing, SweepEvent::Type::Swap, edge1, edge2});
+    }};
+
+    auto check_neighbours{[&](Status::iterator it) {
+        if (it != status.begin())
+            check(slot_edges[*std::prev(it)], slot_edges[*it]);
+        if (std::next(it) != status.end())
+            check(slot_edges[*it], slot_edges[*std::next(it)]);
+    }};
+
+    while (!events.empty()) {
+        SweepEvent event{*events.begin()};
+        events.erase(events.begin());
+        sweep = event.point;
+
+        switch (event.type) {
+            case SweepEvent::Type::Remove: {
+                Status::iterator it{positions[event.edge1]};
+                if ((it != status.begin()) and (std::next(it) != status.end()))
+                    check(slot_edges[*std::prev(it)], slot_edges[*std::next(it)]);
+                status.erase(it);
+                positions[event.edge1] = status.end();
+                break;
+            }
+            case SweepEvent::Type::Swap: {
+                // The lower edge must be just below the upper one, otherwise
+                // the swap waits until they are neighbours again
+                Status::iterator lower{positions[event.edge1]};
+                Status::iterator upper{positions[event.edge2]};
+                if ((lower == status.end()) or (upper == status.end()) or (std::next(lower) != upper)) {
+                    scheduled.erase({std::min(event.edge1, event.edge2), std::max(event.edge1, event.edge2)});
+                    break;
+                }
+
+                std::swap(slot_edges[*lower], slot_edges[*upper]);
+                std::swap(edge_slots[event.edge1], edge_slots[event.edge2]);
+                std::swap(positions[event.edge1], positions[event.edge2]);
+                check_neighbours(positions[event.edge1]);
+                check_neighbours(positions[event.edge2]);
+                break;
+            }
+            case SweepEvent::Type::Insert: {
+                positions[event.edge1] = status.insert(edge_slots[event.edge1]).first;
+                check_neighbours(positions[event.edge1]);
+                break;
+            }
+        }
+    }
+
+    return {crossings.begin(), crossings.end()};
+}
+
+Polygon Polygon::normalize(void) const {
+    // A vertex equal to the next one or aligned with its neighbours is
+    // removed, which may leave its neighbours aligned in turn
+    Points normalized;
+    normalized.reserve(vertices.size());
+    for (const Point &vertex : vertices) {
+        if (!normalized.empty() and (normalized.back() == vertex))
+            continue;
+
+        while ((normalized.size() >= 2) and
+               (predicates::orient2d(normalized[normalized.size() - 2], normalized.back(), vertex) == 0))
+            normalized.pop_back();
+
+        if (normalized.empty() or !(normalized.back() == vertex))
+            normalized.push_back(vertex);
+    }
+
+    // The ring closes through the first vertices
+    size_t first{0};
+    bool changed{true};
+    while (changed and (normalized.size() - first >= 3)) {
+        changed = false;
+        size_t size{normalized.size()};
+        if (normalized.back() == normalized[first]) {
+            normalized.pop_back();
+            changed = true;
+        } else if (predicates::orient2d(normalized[size - 2], normalized.back(), normalized[first]) == 0) {
+            normalized.pop_back();
+            changed = true;
+        } else if (predicates::orient2d(normalized.back(), normalized[first], normalized[first + 1]) == 0) {
+            ++first;
+            changed = true;
+        }
+    }
+    normalized.erase(normalized.begin(), normalized.begin() + static_cast<std::ptrdiff_t>(first));
+
+    if (normalized.size() < 3)
+        throw Polygon::NotEnoughPointsException{"The polygon has fewer than three vertices that are not aligned"};
+
+    Polygon result{std::move(normalized)};
+    std::vector<std::pair<size_t, size_t>> crossings{result.find_crossings()};
+    if (!crossings.empty()) {
+        std::ostringstream message;
+        message << "The edges that begin at " << result[crossings.front().first] << " and "
+                << result[crossings.front().second] << " cross each other";
+        throw Polygon::SelfIntersectionException{message.str()};
+    }
+
+    if (!result.is_clockwise()) {
+        std::reverse(result.vertices.begin(), result.vertices.end());
+        result.invalidate_cache();
+    }
+
+    return result;
+}
@@ -24,35 +24,98 @@
 #include "point.hpp"
 
 struct Vector {
-    Point p;
-    double &x = p.x;
-    double &y = p.y;
-
-    Vector(const Point &p);
-    Vector(const Vector &v);
-    Vector(double x=0.0f, double y=0.0f);
-    Vector &operator=(const Vector &v);
-    Vector operator-() const;
-    Vector &operator+=(const Vector &v);
-    Vector &operator-=(const Vector &v);
-    Vector &operator*=(double v);
-    Vector &operator/=(double v);
-    Vector operator-(const Vector &v) const;
-    Vector operator+(const Vector &v) const;
-    Vector operator*(const double v) const;
-    Vector operator/(const double v) const;
-    double dot(const Vector &v) const;
-    double length(void) const;
-    double square_length(void) const;
-    Vector unit(void) const;
-    Vector norm(void) const;
-    bool operator==(const Vector &v) const;
-    bool operator!=(const Vector &v) const;
-    Vector abs() const;
-    friend Point operator+(const Point &p, const Vector &v);
+    double x, y;
+
+    constexpr Vector(const Point &p) : x(p.x), y(p.y) {}
+    constexpr Vector(const Vector &v) = default;
+    constexpr Vector(double x=0.0f, double y=0.0f) : x(x), y(y) {}
+    constexpr Vector &operator=(const Vector &v) = default;
+
+    constexpr Vector operator-() const {
+        return Vector{-x, -y};
+    }
+
+    constexpr Vector &operator+=(const Vector &v) {
+        return *this = *this + v;
+    }
+
+    constexpr Vector &operator-=(const Vector &v) {
+        return *this = *this - v;
+    }
+
+    constexpr Vector &operator*=(double v) {
+        return *this = *this * v;
+    }
+
+    constexpr Vector &operator/=(double v) {
+        return *this = *this / v;
+    }
+
+    constexpr Vector operator-(const Vector &v) const {
+        return Vector{x - v.x, y - v.y};
+    }
+
+    constexpr Vector operator+(const Vector &v) const {
+        return Vector{x + v.x, y + v.y};
+    }
+
+    constexpr Vector operator*(const double v) const {
+        return Vector{x * v, y * v};
+    }
+
+    constexpr Vector operator/(const double v) const {
+        return Vector{x / v, y / v};
+    }
+
+    constexpr double dot(const Vector &v) const {
+        return x * v.x + y * v.y;
+    }
+
+    constexpr double length(void) const {
+        return poly_private::square_root(square_length());
+    }
+
+    constexpr double square_length(void) const {
+        return Point{x, y}.square_distance(Point{});
+    }
+
+    constexpr Vector unit(void) const {
+        double l = length();
+        if (l == 0)
+            return Vector{};
+        else
+            return Vector{x / l, y / l};
+    }
+
+    constexpr Vector norm(void) const {
+        if (length() == 0)
+            return Vector{};
+        else
+            return Vector{y, -x};
+    }
+
+    constexpr bool operator==(const Vector &v) const {
+        return Point{x, y} == Point{v.x, v.y};
+    }
+
+    constexpr bool operator!=(const Vector &v) const {
+        return Point{x, y} != Point{v.x, v.y};
+    }
+
+    constexpr Vector abs() const {
+        return Vector{Point{x, y}.abs()};
+    }
+
+    friend constexpr Point operator+(const Point &p, const Vector &v) {
+        return Point{p.x + v.x, p.y + v.y};
+    }
+
     friend std::ostream& operator<<(std::ostream &out, const Vector &v);
 };
 
+static_assert(std::is_trivially_copyable_v<Vector> and std::is_standard_layout_v<Vector>);
+static_assert(sizeof(Vector) == 2 * sizeof(double));
+
 using Vectors = std::vector<Vector>;
 using VecIter = std::vector<Vector>::iterator;
 using CVectIter = std::vector<Vector>::const_iterator;
\ No newline at end of file
@@ -21,6 +21,9 @@
 #include <gtest/gtest.h>
 #include "../src/missionhelper/missionhelper.hpp"
 
+#include <atomic>
+#include <thread>
+
 TEST(GoCenterTest, NewMissionThrowException) {
     Polygon poly;
     MissionHelper *mission_helper{new GoCenter{poly}};
@@ -31,6 +34,20 @@ TEST(GoCenterTest, NewMissionThrowException) {
     delete mission_helper;
 }
 
+TEST(GoCenterTest, NewMissionSelfIntersection) {
+    Polygon poly;
+    poly.push_back({47.3978,8.5456});
+    poly.push_back({47.3980,8.5468});
+    poly.push_back({47.3980,8.5456});
+    poly.push_back({47.3978,8.5468});
+    MissionHelper *mission_helper{new GoCenter{poly}};
+    std::vector<Mission::MissionItem> mission_item_list;
+
+    ASSERT_THROW(mission_helper->new_mission(3, mission_item_list, 2), CannotMakeMission);
+
+    delete mission_helper;
+}
+
 TEST(GoCenterTest, NewMission) {
     Polygon poly;
     poly.push_back({0,0});
@@ -108,6 +125,72 @@ TEST(GoCenterTest, NewMission4) {
     delete mission_helper;
 }
 
+TEST(GoCenterTest, NewMissionConcurrent) {
+    Polygon poly;
+    poly.push_back({-20, 10});
+    poly.push_back({-10, 30});
+    poly.push_back({7.5, 30});
+    poly.push_back({15, 10});
+    poly.push_back({22.5, 20});
+    poly.push_back({30, -10});
+    poly.push_back({-25, -10});
+    poly.push_back({-40, -5});
+    poly.push_back({-30, 20});
+
+    const unsigned int number_of_systems{8};
+    GoCenter sequential_helper{poly};
+    GoCenter concurrent_helper{poly};
+    std::vector<std::vector<Mission::MissionItem>> expected_missions(number_of_systems);
+    std::vector<std::vector<Mission::MissionItem>> missions(number_of_systems);
+
+    for (unsigned int i = 0; i < number_of_systems; ++i) {
+        ASSERT_NO_THROW(sequential_helper.new_mission(number_of_systems, expected_missions[i], i + 1));
+    }
+
+    std::vector<std::thread> threads{};
+    for (unsigned int i = 0; i < number_of_systems; ++i) {
+        threads.push_back(std::thread{[&concurrent_helper, &missions, i, number_of_systems]() {
+            concurrent_helper.new_mission(number_of_systems, missions[i], i + 1);
+        }});
+    }
+
+    for (std::thread &th : threads) {
+        th.join();
+    }
+
+    for (unsigned int i = 0; i < number_of_systems; ++i) {
+        ASSERT_EQ(missions[i].size(), 1);
+        ASSERT_EQ(missions[i][0].latitude_deg, expected_missions[i][0].latitude_deg);
+        ASSERT_EQ(missions[i][0].longitude_deg, expected_missions[i][0].longitude_deg);
+    }
+}
+
+struct FailingPartitioner : public AreaPartitioner {
+    mutable std::atomic<unsigned int> calls{0};
+
+    std::vector<Polygon> partition(const Polygon &, const unsigned int) const override {
+        ++calls;
+        throw Polygon::CannotSplitException{"The partition always fails"};
+    }
+};
+
+TEST(GoCenterTest, NewMissionFailedPlan) {
+    Polygon poly;
+    poly.push_back({47.3978,8.5456});
+    poly.push_back({47.3978,8.5468});
+    poly.push_back({47.3980,8.5468});
+    poly.push_back({47.3980,8.5456});
+
+    std::shared_ptr<FailingPartitioner> partitioner{std::make_shared<FailingPartitioner>()};
+    GoCenter mission_helper{poly, partitioner};
+    std::vector<Mission::MissionItem> mission_item_list;
+
+    // A plan that could not be made is computed again on the next request
+    ASSERT_THROW(mission_helper.new_mission(3, mission_item_list, 1), CannotMakeMission);
+    ASSERT_THROW(mission_helper.new_mission(3, mission_item_list, 2), CannotMakeMission);
+    ASSERT_EQ(partitioner->calls, 2);
+}
+
 TEST(SpiralSweepCenterTest, NewMission1) {
     Polygon poly;
     poly.push_back({47.3978,8.5456});
@@ -231,4 +314,60 @@ TEST(ParallelSweep, NewMission2) {
     ASSERT_NO_THROW(mission_helper->new_mission(4, mission_item_list, 4));
 
     delete mission_helper;
-}
\ No newline at end of file
+}
+
+static std::vector<MissionHelper *> make_mission_helpers(const Polygon &poly,
+                                                        std::shared_ptr<const AreaPartitioner> partitioner,
+                                                        const Polygon::Simplification &simplification={}) {
+    return {new GoCenter{poly, partitioner, simplification},
+            new SpiralSweepCenter{poly, 0.000018, partitioner, simplification},
+            new SpiralSweepEdge{poly, 0.000018, partitioner, simplification},
+            new ParallelSweep{poly, 0.000018, partitioner, simplification}};
+}
+
+static void check_new_missions(const std::vector<MissionHelper *> &mission_helpers, const unsigned int number_of_systems) {
+    for (MissionHelper *mission_helper : mission_helpers) {
+        std::vector<Mission::MissionItem> mission_item_list;
+
+        ASSERT_NO_THROW(mission_helper->new_mission(1, mission_item_list, 1));
+        for (unsigned int system_id = 1; system_id <= number_of_systems; ++system_id) {
+            ASSERT_NO_THROW(mission_helper->new_mission(number_of_systems, mission_item_list, system_id));
+        }
+
+        delete mission_helper;
+    }
+}
+
+TEST(BisectionPartitionerTest, NewMission) {
+    Polygon poly;
+    poly.push_back({47.3978,8.5456});
+    poly.push_back({47.3978,8.5468});
+    poly.push_back({47.3980,8.5468});
+    poly.push_back({47.3980,8.5456});
+
+    std::shared_ptr<const AreaPartitioner> partitioner{std::make_shared<BisectionPartitioner>()};
+    check_new_missions(make_mission_helpers(poly, partitioner), 5);
+}
+
+TEST(StripPartitionerTest, NewMission) {
+    Polygon poly;
+    poly.push_back({47.3978,8.5456});
+    poly.push_back({47.3978,8.5468});
+    poly.push_back({47.3980,8.5468});
+    poly.push_back({47.3980,8.5456});
+
+    std::shared_ptr<const AreaPartitioner> partitioner{std::make_shared<StripPartitioner>()};
+    check_new_missions(make_mission_helpers(poly, partitioner), 5);
+}
+
+TEST(PolySplitMissionTest, Simplification) {
+    Polygon poly;
+    for (size_t i = 0; i < 500; ++i) {
+        double angle{2 * M_PI * static_cast<double>(i) / 500};
+        double radius{0.0010 + 0.0000005 * sin(61 * angle)};
+        poly.push_back({47.3979 + radius * cos(angle), 8.5462 + radius * sin(angle)});
+    }
+
+    Polygon::Simplification simplification{Polygon::Simplification::Method::DouglasPeucker, 0.000002};
+    check_new_missions(make_mission_helpers(poly, nullptr, simplification), 3);
+}
@@ -0,0 +1,99 @@
+/**
+ * The MIT License (MIT)
+ * Copyright (c) 2023 Pablo López Sedeño
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+#include "../src/poly/polygon.hpp"
+
+/**
+ * @brief Returns the mean time in nanoseconds of each call to the function.
+*/
+template <typename F>
+double measure(size_t repetitions, F function) {
+    volatile double sink{0};
+    std::chrono::steady_clock::time_point start{std::chrono::steady_clock::now()};
+    for (size_t i = 0; i < repetitions; ++i) {
+        sink = sink + function(i);
+    }
+    std::chrono::steady_clock::time_point end{std::chrono::steady_clock::now()};
+
+    return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(repetitions);
+}
+
+void print(const char *name, double scalar_time, double simd_time) {
+    std::cout << "  " << name << ": " << scalar_time << " ns scalar, "
+              << simd_time << " ns vectorized (x" << scalar_time / simd_time << ")" << std::endl;
+}
+
+int main() {
+    std::cout << "Instruction set: " << poly_private::kernel_instruction_set() << std::endl;
+
+    for (size_t n_vertices : {16, 1000, 100000}) {
+        Points points;
+        for (size_t i = 0; i < n_vertices; ++i) {
+            double angle{2 * M_PI * static_cast<double>(i) / static_cast<double>(n_vertices)};
+            double radius{(i % 2 == 0) ? 100.0 : 80.0};
+            points.push_back(Point{radius * cos(angle), radius * sin(angle)});
+        }
+        const poly_private::VertexArray array{points};
+        const size_t repetitions{std::max<size_t>(10, 10000000 / n_vertices)};
+        auto point{[](size_t i) {
+            return Point{static_cast<double>(i % 200) - 100, static_cast<double>(i % 170) - 85};
+        }};
+
+        std::cout << n_vertices << " vertices" << std::endl;
+
+        print("signed square",
+              measure(repetitions, [&](size_t) { return poly_private::signed_square_scalar(array); }),
+              measure(repetitions, [&](size_t) { return poly_private::signed_square(array); }));
+        print("clockwise sum",
+              measure(repetitions, [&](size_t) { return poly_private::clockwise_sum_scalar(array); }),
+              measure(repetitions, [&](size_t) { return poly_private::clockwise_sum(array); }));
+        print("distance",
+              measure(repetitions, [&](size_t i) { return poly_private::min_distance_scalar(array, point(i)); }),
+              measure(repetitions, [&](size_t i) { return poly_private::min_distance(array, point(i)); }));
+        print("point inside",
+              measure(repetitions, [&](size_t i) { return poly_private::crossing_count_scalar(array, point(i)); }),
+              measure(repetitions, [&](size_t i) { return poly_private::crossing_count(array, point(i)); }));
+
+        // Per point, testing the points in blocks
+        const size_t batch_size{256};
+        Points batch;
+        for (size_t i = 0; i < batch_size; ++i) {
+            batch.push_back(point(i));
+        }
+        std::vector<uint8_t> inside(batch_size);
+        const size_t batch_repetitions{std::max<size_t>(2, repetitions / batch_size)};
+        print("batch point inside",
+              measure(batch_repetitions, [&](size_t) {
+                  poly_private::points_inside_scalar(array, batch, inside);
+                  return inside[0];
+              }) / batch_size,
+              measure(batch_repetitions, [&](size_t) {
+                  poly_private::points_inside(array, batch, inside);
+                  return inside[0];
+              }) / batch_size);
+    }
+
+    return 0;
+}
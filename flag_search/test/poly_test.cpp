@@ -20,9 +20,40 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cmath>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <utility>
 
 #include "../src/poly/polygon.hpp"
+#include "../src/poly/partitioner.hpp"
+#include "../src/poly/predicates.hpp"
+
+/**
+ * @brief Number of calls to operator new, used to check that some
+ * operations do not copy the vertices.
+*/
+static std::atomic<size_t> allocation_count{0};
+
+[[gnu::noinline]] void *operator new(size_t size) {
+    ++allocation_count;
+    if (void *p = std::malloc(size ? size : 1))
+        return p;
+
+    throw std::bad_alloc{};
+}
+
+[[gnu::noinline]] void operator delete(void *p) noexcept {
+    std::free(p);
+}
+
+[[gnu::noinline]] void operator delete(void *p, size_t) noexcept {
+    operator delete(p);
+}
 
 /* Point Tests */
 TEST(PointTest, DefaultPoint) {
@@ -703,8 +734,7 @@ TEST(PolygonTest, ChangingPoint) {
 
     Point new_p1{5, 8};
 
-    pol[1].x = new_p1.x;
-    pol[1].y = new_p1.y;
+    pol.set(1, new_p1);
 
     ASSERT_EQ(pol[1], new_p1);
 }
@@ -981,3 +1011,868 @@ TEST(PolygonTest, IsClockWiseException) {
 
     ASSERT_THROW(pol.is_clockwise(), Polygon::NotEnoughPointsException);
 }
+
+TEST(PolygonTest, SplitConcave) {
+    Points original_points;
+    original_points.push_back(Point{});
+    original_points.push_back(Point{0, 4});
+    original_points.push_back(Point{4, 4});
+    original_points.push_back(Point{4, 2});
+    original_points.push_back(Point{2, 2});
+    original_points.push_back(Point{2, 0});
+    const Polygon original_poly{original_points};
+    Polygon first_poly;
+    Polygon second_poly;
+    Segment cut_line;
+    const double expected_area{5};
+
+    ASSERT_NO_THROW(original_poly.split(expected_area, first_poly, second_poly, cut_line));
+    ASSERT_NEAR(second_poly.count_square(), expected_area, POLY_SPLIT_EPS);
+    ASSERT_NEAR(first_poly.count_square() + second_poly.count_square(), original_poly.count_square(), POLY_SPLIT_EPS);
+}
+
+TEST(PolygonTest, SplitMany) {
+    Points original_points;
+    original_points.push_back(Point{});
+    original_points.push_back(Point{0, 4});
+    original_points.push_back(Point{4, 4});
+    original_points.push_back(Point{4, 2});
+    original_points.push_back(Point{2, 2});
+    original_points.push_back(Point{2, 0});
+    const Polygon original_poly{original_points};
+    const std::vector<double> areas{1, 2.5, 5, 7.5, 11};
+
+    std::vector<Polygon::SplitResult> results{original_poly.split_many(areas)};
+
+    ASSERT_EQ(results.size(), areas.size());
+    for (size_t k = 0; k < areas.size(); ++k) {
+        Polygon first_poly;
+        Polygon second_poly;
+        Segment cut_line;
+
+        ASSERT_NO_THROW(original_poly.split(areas[k], first_poly, second_poly, cut_line));
+        ASSERT_EQ(results[k].cut_line, cut_line);
+        ASSERT_EQ(results[k].poly1.size(), first_poly.size());
+        ASSERT_EQ(results[k].poly2.size(), second_poly.size());
+        ASSERT_EQ(results[k].poly2.count_square(), second_poly.count_square());
+    }
+}
+
+TEST(PolygonTest, SplitManyFalse) {
+    Points original_points;
+    original_points.push_back(Point{});
+    original_points.push_back(Point{2, 0});
+    original_points.push_back(Point{2, 2});
+    original_points.push_back(Point{0, 2});
+    const Polygon original_poly{original_points};
+    const std::vector<double> areas{1, 300};
+
+    ASSERT_THROW(original_poly.split_many(areas), Polygon::CannotSplitException);
+}
+
+TEST(PolygonTest, EdgeTableInvalidation) {
+    Polygon poly;
+    poly.push_back(Point{});
+    poly.push_back(Point{2, 0});
+    poly.push_back(Point{2, 2});
+
+    const Point point{0, 3};
+
+    ASSERT_FALSE(poly.is_point_inside(Point{0.5, 1.5}));
+    ASSERT_EQ(poly.find_nearest_point(point), (Point{1.5, 1.5}));
+
+    poly.push_back(Point{0, 2});
+
+    ASSERT_TRUE(poly.is_point_inside(Point{0.5, 1.5}));
+    ASSERT_EQ(poly.find_distance(point), 1);
+
+    poly.set(3, Point{poly[3].x, 4});
+
+    ASSERT_EQ(poly.find_distance(point), 0);
+
+    poly.split_nearest_edge(Point{3, 1});
+
+    ASSERT_EQ(poly.size(), 5);
+    ASSERT_EQ(poly.find_nearest_point(Point{3, 1}), (Point{2, 1}));
+
+    poly.clear();
+
+    ASSERT_THROW(poly.find_distance(point), Polygon::NotEnoughPointsException);
+}
+
+TEST(PolygonTest, EdgeTreeMatchesScan) {
+    const size_t n_vertices{200};
+    Polygon poly;
+    for (size_t i = 0; i < n_vertices; ++i) {
+        double angle{2 * M_PI * static_cast<double>(i) / static_cast<double>(n_vertices)};
+        double radius{(i % 2 == 0) ? 10.0 : 7.0};
+        poly.push_back(Point{radius * cos(angle), radius * sin(angle)});
+    }
+
+    const poly_private::VertexArray array{poly.get_vertices()};
+    for (double x = -12; x <= 12; x += 1.7) {
+        for (double y = -12; y <= 12; y += 1.7) {
+            const Point point{x, y};
+            double expected_distance{std::numeric_limits<double>::infinity()};
+            for (size_t i = 0; i < n_vertices; ++i) {
+                const Segment edge{poly[i], poly[(i + 1) % n_vertices]};
+                expected_distance = std::min(expected_distance, edge.get_nearest_point(point).distance(point));
+            }
+
+            ASSERT_NEAR(poly.find_distance(point), expected_distance, POLY_SPLIT_EPS);
+            ASSERT_NEAR(poly.find_distance(point), poly_private::min_distance_scalar(array, point), POLY_SPLIT_EPS);
+            ASSERT_NEAR(poly.find_nearest_point(point).distance(point), expected_distance, POLY_SPLIT_EPS);
+        }
+    }
+
+    // The points just outside of the boundary are taken as inside
+    for (size_t i = 0; i < n_vertices; ++i) {
+        const Point middle{(poly[i] + poly[(i + 1) % n_vertices]) / 2};
+        const Point outside{middle * (1 + POLY_SPLIT_EPS / (2 * middle.distance(Point{})))};
+
+        ASSERT_TRUE(poly.is_point_inside(outside));
+    }
+
+    ASSERT_TRUE(poly.is_segment_inside(Segment{Point{-5, -1}, Point{5, 2}}, n_vertices, n_vertices));
+    ASSERT_FALSE(poly.is_segment_inside(Segment{Point{-5, -1}, Point{11, 0.5}}, n_vertices, n_vertices));
+}
+
+TEST(PolygonTest, PointLocatorMatchesScan) {
+    const size_t n_vertices{300};
+    Points points;
+    for (size_t i = 0; i < n_vertices; ++i) {
+        double angle{2 * M_PI * static_cast<double>(i) / static_cast<double>(n_vertices)};
+        double radius{(i % 3 == 0) ? 10.0 : 4.0};
+        points.push_back(Point{radius * cos(angle), radius * sin(angle)});
+    }
+    const Polygon poly{points};
+    const poly_private::VertexArray array{points};
+
+    for (double x = -11; x <= 11; x += 0.13) {
+        for (double y = -11; y <= 11; y += 0.17) {
+            const Point point{x, y};
+            const bool expected{(poly_private::min_distance(array, point) <= POLY_SPLIT_EPS) or
+                                (poly_private::crossing_count(array, point) % 2 != 0)};
+
+            ASSERT_EQ(poly.is_point_inside(point), expected);
+        }
+    }
+
+    for (const Point &vertex : points) {
+        ASSERT_TRUE(poly.is_point_inside(vertex));
+    }
+}
+
+TEST(PolygonTest, CachedProperties) {
+    Polygon poly;
+    poly.push_back(Point{0, 0});
+    poly.push_back(Point{0, 4});
+    poly.push_back(Point{4, 4});
+    poly.push_back(Point{4, 0});
+
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_DOUBLE_EQ(poly.count_square(), 16);
+        ASSERT_FALSE(poly.is_clockwise());
+        ASSERT_EQ(poly.find_center(), Point(2, 2));
+        ASSERT_EQ(poly.find_min_corner(), Point(0, 0));
+        ASSERT_EQ(poly.find_max_corner(), Point(4, 4));
+    }
+    ASSERT_EQ(poly.get_cache_statistics().property_builds, 1);
+
+    Polygon poly1, poly2;
+    Segment cut_line;
+    poly.split(4, poly1, poly2, cut_line);
+    poly.split(8, poly1, poly2, cut_line);
+    ASSERT_EQ(poly.get_cache_statistics().property_builds, 1);
+    ASSERT_EQ(poly.get_cache_statistics().vertex_array_builds, 1);
+
+    // Reading a vertex keeps the cached data, writing it clears the data
+    ASSERT_EQ(poly[2], Point(4, 4));
+    ASSERT_EQ(poly.get_cache_statistics().property_builds, 1);
+    ASSERT_EQ(poly.get_cache_statistics().vertex_array_builds, 1);
+
+    poly.set(2, Point{8, 4});
+    ASSERT_DOUBLE_EQ(poly.count_square(), 24);
+    ASSERT_EQ(poly.find_max_corner(), Point(8, 4));
+    ASSERT_EQ(poly.get_cache_statistics().property_builds, 2);
+
+    poly.split_nearest_edge(Point{2, 5});
+    ASSERT_EQ(poly.find_center(), Point(14.0 / 5, 12.0 / 5));
+    ASSERT_EQ(poly.get_cache_statistics().property_builds, 3);
+
+    poly.clear();
+    ASSERT_DOUBLE_EQ(poly.count_square(), 0);
+    ASSERT_THROW(poly.find_min_corner(), Polygon::NotEnoughPointsException);
+}
+
+TEST(PolygonTest, ContainsMatchesIsPointInside) {
+    Points star;
+    for (size_t i = 0; i < 100; ++i) {
+        double angle{2 * M_PI * static_cast<double>(i) / 100.0};
+        double radius{(i % 2 == 0) ? 10.0 : 3.0};
+        star.push_back(Point{radius * cos(angle), radius * sin(angle)});
+    }
+    Points square;
+    square.push_back(Point{0, 0});
+    square.push_back(Point{0, 4});
+    square.push_back(Point{4, 4});
+    square.push_back(Point{4, 0});
+
+    for (const Points &vertices : {star, square}) {
+        const Polygon poly{vertices};
+        Points points{vertices};
+        for (double x = -11; x <= 11; x += 0.21) {
+            for (double y = -11; y <= 11; y += 0.19) {
+                points.push_back(Point{x, y});
+            }
+        }
+
+        std::vector<uint8_t> inside(points.size());
+        poly.contains(points, inside);
+        for (size_t i = 0; i < points.size(); ++i) {
+            ASSERT_EQ(inside[i] != 0, poly.is_point_inside(points[i]));
+        }
+
+        std::vector<uint8_t> scalar_inside(points.size());
+        poly_private::points_inside_scalar(poly_private::VertexArray{vertices}, points, scalar_inside);
+        ASSERT_EQ(scalar_inside, inside);
+    }
+
+    std::vector<uint8_t> too_small(1);
+    ASSERT_THROW(Polygon{square}.contains(square, too_small), std::invalid_argument);
+}
+
+TEST(PolygonTest, MoveWithoutCopies) {
+    Points points;
+    for (int i = 0; i < 64; ++i) {
+        double angle{2 * M_PI * i / 64.0};
+        points.push_back(Point{cos(angle), sin(angle)});
+    }
+    Polygon poly{points};
+    const double square{poly.count_square()};
+    ASSERT_TRUE(poly.is_point_inside(Point{}));
+
+    size_t first_count{allocation_count};
+    Polygon moved{std::move(poly)};
+    Polygon assigned;
+    assigned = std::move(moved);
+    double sum{0};
+    for (const Point &p : assigned.get_vertices_view()) {
+        sum += p.x;
+    }
+    for (const Point &p : assigned.get_vertices()) {
+        sum += p.y;
+    }
+    sum += std::as_const(assigned)[3].x;
+    const double assigned_square{assigned.count_square()};
+    const bool inside{assigned.is_point_inside(Point{})};
+    const size_t last_count{allocation_count};
+
+    ASSERT_EQ(last_count, first_count);
+    ASSERT_DOUBLE_EQ(assigned_square, square);
+    ASSERT_TRUE(inside);
+
+    // The cached data travel with the vertices
+    ASSERT_EQ(assigned.get_cache_statistics().property_builds, 0);
+    ASSERT_EQ(assigned.get_cache_statistics().point_locator_builds, 0);
+    ASSERT_TRUE(poly.empty());
+    ASSERT_TRUE(moved.empty());
+    ASSERT_DOUBLE_EQ(moved.count_square(), 0);
+    ASSERT_EQ(assigned.size(), points.size());
+    ASSERT_NEAR(sum, std::as_const(assigned)[3].x, 1E-9);
+}
+
+TEST(PolygonTest, SplitAllocations) {
+    Points points;
+    for (int i = 0; i < 200; ++i) {
+        double angle{2 * M_PI * i / 200.0};
+        double radius{(i % 2 == 0) ? 10.0 : 8.0};
+        points.push_back(Point{radius * cos(angle), radius * sin(angle)});
+    }
+    const Polygon poly{points};
+    Polygon poly1, poly2;
+    Segment cut_line;
+    Polygon::SplitStatistics statistics;
+    poly.split(poly.count_square() / 3, poly1, poly2, cut_line);
+
+    // The decompositions of the pairs are kept inside their objects
+    size_t first_count{allocation_count};
+    poly.split(poly.count_square() / 3, poly1, poly2, cut_line, &statistics);
+    size_t split_count{allocation_count - first_count};
+
+    ASSERT_GT(statistics.evaluated_pairs, points.size());
+    ASSERT_LT(split_count, points.size());
+}
+
+TEST(PolygonTest, SmallPolygon) {
+    size_t first_count{allocation_count};
+    SmallPolygon<4> rectangle{Point{0, 0}, Point{0, 2}, Point{3, 2}, Point{3, 0}};
+    const double square{rectangle.count_square()};
+    const Point center{rectangle.find_center()};
+
+    // The decompositions of split do not allocate
+    const Segment s1{Point{0, 0}, Point{4, 0}};
+    const Segment s2{Point{5, 3}, Point{-1, 3}};
+    const poly_private::Polygons polygons{s1, s2};
+    const size_t last_count{allocation_count};
+
+    ASSERT_EQ(last_count, first_count);
+    ASSERT_DOUBLE_EQ(square, 6);
+    ASSERT_EQ(center, Point(1.5, 1));
+    ASSERT_NEAR(polygons.total_square, 15, 1E-9);
+    ASSERT_THROW(rectangle.push_back(Point{1, -1}), std::length_error);
+
+    const SmallPolygon<4> copy{rectangle};
+    Polygon grown{rectangle.to_polygon()};
+    grown.push_back(Point{1, -1});
+    ASSERT_DOUBLE_EQ(copy.count_square(), 6);
+    ASSERT_TRUE(grown.is_point_inside(Point{1, 1}));
+    ASSERT_DOUBLE_EQ(grown.count_square(), 7.5);
+    static_assert(std::is_trivially_copyable_v<SmallPolygon<4>>);
+}
+
+TEST(PolygonTest, IsConvex) {
+    Points rectangle;
+    rectangle.push_back(Point{0, 0});
+    rectangle.push_back(Point{0, 2});
+    rectangle.push_back(Point{0, 4});
+    rectangle.push_back(Point{6, 4});
+    rectangle.push_back(Point{6, 0});
+    ASSERT_TRUE(Polygon{rectangle}.is_convex());
+
+    Points pentagram;
+    for (int i = 0; i < 5; ++i) {
+        double angle{4 * M_PI * i / 5.0};
+        pentagram.push_back(Point{cos(angle), sin(angle)});
+    }
+    ASSERT_FALSE(Polygon{pentagram}.is_convex());
+
+    Points concave{rectangle};
+    concave[1] = Point{1, 2};
+    ASSERT_FALSE(Polygon{concave}.is_convex());
+
+    Points repeated{rectangle};
+    repeated.insert(repeated.begin() + 3, Point{0, 4});
+    ASSERT_FALSE(Polygon{repeated}.is_convex());
+}
+
+TEST(PolygonTest, ConvexFastPath) {
+    const size_t n_vertices{90};
+    Points points;
+    for (size_t i = 0; i < n_vertices; ++i) {
+        double angle{2 * M_PI * static_cast<double>(i * i) / static_cast<double>(n_vertices * n_vertices)};
+        points.push_back(Point{20 * cos(angle), 7 * sin(angle)});
+    }
+    const Polygon poly{points};
+    const poly_private::VertexArray array{points};
+    ASSERT_TRUE(poly.is_convex());
+
+    // split_many always evaluates every pair
+    for (double fraction : {0.1, 0.3, 0.5, 0.8}) {
+        double areas[]{poly.count_square() * fraction};
+        Polygon poly1, poly2;
+        Segment cut_line;
+        Polygon::SplitStatistics statistics;
+        poly.split(areas[0], poly1, poly2, cut_line, &statistics);
+        const Polygon::SplitResult expected{poly.split_many(areas)[0]};
+
+        ASSERT_EQ(cut_line.get_start().x, expected.cut_line.get_start().x);
+        ASSERT_EQ(cut_line.get_start().y, expected.cut_line.get_start().y);
+        ASSERT_EQ(cut_line.get_end().x, expected.cut_line.get_end().x);
+        ASSERT_EQ(cut_line.get_end().y, expected.cut_line.get_end().y);
+        ASSERT_EQ(poly1.get_vertices(), expected.poly1.get_vertices());
+        ASSERT_LT(statistics.evaluated_pairs, 4 * n_vertices);
+    }
+
+    Points queries{points};
+    for (size_t i = 0; i < n_vertices; ++i) {
+        queries.push_back((points[i] + points[(i + 1) % n_vertices]) / 2);
+    }
+    for (double x = -21; x <= 21; x += 0.37) {
+        for (double y = -8; y <= 8; y += 0.23) {
+            queries.push_back(Point{x, y});
+        }
+    }
+
+    std::vector<uint8_t> inside(queries.size());
+    poly.contains(queries, inside);
+    for (size_t i = 0; i < queries.size(); ++i) {
+        const bool expected{(poly_private::min_distance(array, queries[i]) <= POLY_SPLIT_EPS) or
+                            (poly_private::crossing_count(array, queries[i]) % 2 != 0)};
+
+        ASSERT_EQ(poly.is_point_inside(queries[i]), expected);
+        ASSERT_EQ(inside[i] != 0, expected);
+    }
+}
+
+TEST(PolygonTest, ConvexFastPathRandom) {
+    std::mt19937 generator{42};
+    std::uniform_real_distribution<double> unit{0, 1};
+
+    for (size_t k = 0; k < 200; ++k) {
+        // Vertices on a rotated ellipse, each one in its own angular sector
+        const size_t n_vertices{3 + static_cast<size_t>(unit(generator) * 40)};
+        const double a{1 + 50 * unit(generator)};
+        const double b{1 + 50 * unit(generator)};
+        const double rotation{2 * M_PI * unit(generator)};
+        const Point center{100 * unit(generator) - 50, 100 * unit(generator) - 50};
+        Points points;
+        for (size_t i = 0; i < n_vertices; ++i) {
+            double angle{2 * M_PI * (static_cast<double>(i) + 0.8 * unit(generator)) / static_cast<double>(n_vertices)};
+            Point vertex{a * cos(angle), b * sin(angle)};
+            points.push_back(center + Point{vertex.x * cos(rotation) - vertex.y * sin(rotation),
+                                            vertex.x * sin(rotation) + vertex.y * cos(rotation)});
+        }
+        const Polygon poly{points};
+        ASSERT_TRUE(poly.is_convex());
+
+        // split_many always evaluates every pair
+        double areas[]{poly.count_square() * (0.05 + 0.9 * unit(generator))};
+        Polygon poly1, poly2;
+        Segment cut_line;
+        poly.split(areas[0], poly1, poly2, cut_line);
+        const Polygon::SplitResult expected{poly.split_many(areas)[0]};
+
+        ASSERT_NEAR(cut_line.length(), expected.cut_line.length(), 1E-9);
+    }
+}
+
+/* SquarePrefix Tests */
+static bool is_simple(const Polygon &poly) {
+    const size_t n{poly.size()};
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = i + 1; j < n; ++j) {
+            if (j == i + 1 || (i == 0 && j == n - 1))
+                continue;
+
+            const Point &a{poly[i]}, &b{poly[(i + 1) % n]}, &c{poly[j]}, &d{poly[(j + 1) % n]};
+            double o1{predicates::orient2d(a, b, c)}, o2{predicates::orient2d(a, b, d)};
+            double o3{predicates::orient2d(c, d, a)}, o4{predicates::orient2d(c, d, b)};
+            if (o1 * o2 <= 0 && o3 * o4 <= 0)
+                return false;
+        }
+    }
+
+    return true;
+}
+
+TEST(PolygonTest, SimplifyDouglasPeucker) {
+    const size_t n_vertices{2000};
+    Points points;
+    for (size_t i = 0; i < n_vertices; ++i) {
+        double angle{2 * M_PI * static_cast<double>(i) / static_cast<double>(n_vertices)};
+        double radius{10 + 2 * sin(5 * angle) + 0.01 * sin(97 * angle)};
+        points.push_back(Point{radius * cos(angle), radius * sin(angle)});
+    }
+    const Polygon poly{points};
+
+    const double tolerance{0.05};
+    const Polygon simplified{poly.simplify_douglas_peucker(tolerance)};
+    ASSERT_LT(simplified.size(), n_vertices / 10);
+    ASSERT_EQ(simplified.is_clockwise(), poly.is_clockwise());
+    ASSERT_TRUE(is_simple(simplified));
+    for (const Point &point : points)
+        ASSERT_LE(simplified.find_distance(point), tolerance);
+
+    // A thin band that collapses if the chains are simplified independently
+    Points band;
+    for (size_t i = 0; i <= 200; ++i) {
+        double angle{1.8 * M_PI * static_cast<double>(i) / 200};
+        band.push_back(Point{10 * cos(angle), 10 * sin(angle)});
+    }
+    for (size_t i = 0; i <= 200; ++i) {
+        double angle{1.8 * M_PI * static_cast<double>(200 - i) / 200};
+        band.push_back(Point{9.9 * cos(angle), 9.9 * sin(angle)});
+    }
+    const Polygon band_poly{band};
+    const Polygon band_simplified{band_poly.simplify_douglas_peucker(1)};
+    ASSERT_LT(band_simplified.size(), band.size());
+    ASSERT_EQ(band_simplified.is_clockwise(), band_poly.is_clockwise());
+    ASSERT_TRUE(is_simple(band_simplified));
+
+    ASSERT_THROW(poly.simplify_douglas_peucker(-1), std::invalid_argument);
+}
+
+TEST(PolygonTest, SimplifyVisvalingamWhyatt) {
+    const size_t n_vertices{2000};
+    Points points;
+    for (size_t i = 0; i < n_vertices; ++i) {
+        double angle{2 * M_PI * static_cast<double>(i) / static_cast<double>(n_vertices)};
+        double radius{10 + 2 * sin(5 * angle) + 0.01 * sin(97 * angle)};
+        points.push_back(Point{radius * cos(angle), radius * sin(angle)});
+    }
+    const Polygon poly{points};
+
+    const double max_area_error{0.5};
+    const Polygon simplified{poly.simplify_visvalingam_whyatt(max_area_error)};
+    ASSERT_LT(simplified.size(), n_vertices / 10);
+    ASSERT_LE(fabs(simplified.count_square() - poly.count_square()), max_area_error);
+    ASSERT_EQ(simplified.is_clockwise(), poly.is_clockwise());
+    ASSERT_TRUE(is_simple(simplified));
+
+    Polygon::Simplification simplification{Polygon::Simplification::Method::VisvalingamWhyatt, max_area_error};
+    ASSERT_EQ(poly.simplify(simplification).get_vertices(), simplified.get_vertices());
+    ASSERT_EQ(poly.simplify(Polygon::Simplification{}).get_vertices(), poly.get_vertices());
+
+    const Polygon triangle{Points{{0, 0}, {1, 0}, {0, 1}}};
+    ASSERT_EQ(triangle.simplify_visvalingam_whyatt(10).size(), 3);
+}
+
+static void check_triangulation(const Polygon &poly) {
+    const Triangulation &triangulation{poly.triangulate()};
+    ASSERT_EQ(triangulation.size(), poly.size() - 2);
+    ASSERT_NEAR(triangulation.get_area(), poly.count_square(), 1e-9 * poly.count_square());
+
+    for (const Triangulation::Triangle &triangle : triangulation.get_triangles()) {
+        const Point &a{poly[triangle[0]]}, &b{poly[triangle[1]]}, &c{poly[triangle[2]]};
+        double orientation{predicates::orient2d(a, b, c)};
+        if (orientation != 0) {
+            ASSERT_EQ(orientation > 0, poly.is_clockwise());
+            ASSERT_TRUE(poly.is_point_inside((a + b + c) / 3));
+        }
+    }
+}
+
+TEST(PolygonTest, Triangulate) {
+    // Small polygons are clipped ear by ear
+    const Polygon small{Points{{0, 0}, {4, 0}, {4, 3}, {2, 1}, {0, 3}}};
+    check_triangulation(small);
+
+    Points star;
+    for (size_t i = 0; i < 2000; ++i) {
+        double angle{2 * M_PI * static_cast<double>(i) / 2000};
+        double radius{10 + 2 * sin(5 * angle) + 0.5 * sin(97 * angle)};
+        star.push_back(Point{radius * cos(angle), radius * sin(angle)});
+    }
+    check_triangulation(Polygon{star});
+
+    // The teeth pointing up and down give split and merge vertices
+    Points comb;
+    for (int i = 0; i < 50; ++i) {
+        comb.push_back(Point{2.0 * i, 0});
+        comb.push_back(Point{2.0 * i + 1, -5.0 - (i % 3)});
+    }
+    comb.push_back(Point{100, 0});
+    for (int i = 50; i > 0; --i) {
+        comb.push_back(Point{2.0 * i, 1});
+        comb.push_back(Point{2.0 * i - 1, 6.0 + (i % 4)});
+    }
+    comb.push_back(Point{0, 1});
+    const Polygon comb_poly{comb};
+    check_triangulation(comb_poly);
+
+    std::reverse(comb.begin(), comb.end());
+    check_triangulation(Polygon{comb});
+
+    const Triangulation &triangulation{comb_poly.triangulate()};
+    ASSERT_EQ(&comb_poly.triangulate(), &triangulation);
+    ASSERT_EQ(comb_poly.get_cache_statistics().triangulation_builds, 1);
+    ASSERT_EQ(triangulation.find_triangle(0), 0);
+    ASSERT_EQ(triangulation.find_triangle(triangulation.get_area()), triangulation.size() - 1);
+    for (size_t i = 0; i < triangulation.size(); ++i)
+        ASSERT_EQ(triangulation.find_triangle(triangulation.get_cumulative_area(i)), i);
+
+    for (int i = 0; i < 1000; ++i) {
+        double r1{(i % 100) / 100.0}, r2{(i % 37) / 37.0}, r3{(i % 11) / 11.0};
+        Point point{comb_poly.sample_point(r1, r2, r3)};
+        ASSERT_TRUE(comb_poly.is_point_inside(point) or comb_poly.find_distance(point) < 1e-9);
+    }
+
+    ASSERT_TRUE(Polygon{}.triangulate().empty());
+    ASSERT_THROW(Polygon{}.sample_point(0.5, 0.5, 0.5), Polygon::NotEnoughPointsException);
+}
+
+TEST(PolygonTest, FindCrossings) {
+    const Polygon square{Points{{0, 0}, {2, 0}, {2, 2}, {0, 2}}};
+    ASSERT_TRUE(square.find_crossings().empty());
+
+    const Polygon bow_tie{Points{{0, 0}, {2, 2}, {2, 0}, {0, 2}}};
+    std::vector<std::pair<size_t, size_t>> expected{{0, 2}};
+    ASSERT_EQ(bow_tie.find_crossings(), expected);
+
+    // A vertex on another edge, a repeated vertex and a spike
+    const Polygon touching{Points{{0, 0}, {4, 0}, {4, 4}, {2, 0}, {0, 4}}};
+    expected = {{0, 2}, {0, 3}};
+    ASSERT_EQ(touching.find_crossings(), expected);
+    const Polygon repeated{Points{{0, 0}, {2, 0}, {2, 0}, {2, 2}, {0, 2}}};
+    ASSERT_TRUE(repeated.find_crossings().empty());
+    const Polygon spike{Points{{0, 0}, {2, 0}, {3, 0}, {2, 0}, {2, 2}}};
+    ASSERT_FALSE(spike.find_crossings().empty());
+
+    // Vertical edges and several vertices on the same sweep line
+    const Polygon steps{Points{{0, 0}, {2, 0}, {2, 1}, {1, 1}, {1, 2}, {2, 2}, {2, 3}, {0, 3}}};
+    ASSERT_TRUE(steps.find_crossings().empty());
+    const Polygon comb{Points{{0, 0}, {4, 0}, {4, 4}, {2, 4}, {2, -1}, {1, -1}, {1, 4}, {0, 4}}};
+    expected = {{0, 3}, {0, 5}};
+    ASSERT_EQ(comb.find_crossings(), expected);
+
+    // Same result as comparing every pair of edges
+    Points star;
+    for (size_t i = 0; i < 300; ++i) {
+        double angle{2 * M_PI * static_cast<double>((i * 7) % 300) / 300};
+        double radius{(i % 2 == 0) ? 10.0 : 4.0};
+        star.push_back(Point{radius * cos(angle), radius * sin(angle)});
+    }
+    const Polygon star_poly{star};
+    std::vector<std::pair<size_t, size_t>> brute_force;
+    for (size_t i = 0; i < star.size(); ++i) {
+        for (size_t j = i + 2; j < star.size(); ++j) {
+            if ((i == 0) and (j == star.size() - 1))
+                continue;
+            const Segment edge1{star[i], star[(i + 1) % star.size()]};
+            const Segment edge2{star[j], star[(j + 1) % star.size()]};
+            if (predicates::segments_touch(edge1.get_start(), edge1.get_end(), edge2.get_start(), edge2.get_end()))
+                brute_force.emplace_back(i, j);
+        }
+    }
+    ASSERT_FALSE(brute_force.empty());
+    ASSERT_EQ(star_poly.find_crossings(), brute_force);
+}
+
+TEST(PolygonTest, Normalize) {
+    const Polygon poly{Points{{0, 0}, {0, 0}, {1, 0}, {2, 0}, {2, 1}, {2, 2}, {0, 2}, {0, 1}}};
+    const Polygon normalized{poly.normalize()};
+    ASSERT_EQ(normalized.size(), 4);
+    ASSERT_TRUE(normalized.is_clockwise());
+    ASSERT_DOUBLE_EQ(normalized.count_square(), poly.count_square());
+
+    Points reversed{poly.get_vertices()};
+    std::reverse(reversed.begin(), reversed.end());
+    ASSERT_EQ(Polygon{reversed}.normalize().count_square_signed(), normalized.count_square_signed());
+
+    const Polygon bow_tie{Points{{0, 0}, {2, 2}, {2, 0}, {0, 2}}};
+    ASSERT_THROW(bow_tie.normalize(), Polygon::SelfIntersectionException);
+    const Polygon line{Points{{0, 0}, {1, 1}, {2, 2}, {1, 1}}};
+    ASSERT_THROW(line.normalize(), Polygon::NotEnoughPointsException);
+}
+
+TEST(SquarePrefixTest, ChainSquare) {
+    Points points;
+    points.push_back(Point{});
+    points.push_back(Point{0, 4});
+    points.push_back(Point{4, 4});
+    points.push_back(Point{4, 2});
+    points.push_back(Point{2, 2});
+    points.push_back(Point{2, 0});
+    const poly_private::SquarePrefix square_prefix{points};
+
+    for (size_t first = 0; first < points.size(); ++first) {
+        for (size_t last = 0; last < points.size(); ++last) {
+            Polygon chain;
+            for (size_t i = first; i != last; i = (i + 1) % points.size()) {
+                chain.push_back(points[i]);
+            }
+            chain.push_back(points[last]);
+
+            ASSERT_NEAR(square_prefix.chain_square_signed(first, last), chain.count_square_signed(), POLY_SPLIT_EPS);
+        }
+    }
+}
+
+/* Predicates Tests */
+TEST(PredicatesTest, Orient2dNearlyAligned) {
+    const Point b{12, 12};
+    const Point c{24, 24};
+
+    for (int k = -5; k <= 5; ++k) {
+        const Point a{0.5 + k * std::numeric_limits<double>::epsilon(), 0.5};
+        const double expected{static_cast<double>((k < 0) - (k > 0))};
+        const double result{predicates::orient2d(a, b, c)};
+
+        ASSERT_EQ((result > 0) - (result < 0), expected);
+        ASSERT_EQ((result > 0) - (result < 0), (predicates::orient2d_exact(a, b, c) > 0) - (predicates::orient2d_exact(a, b, c) < 0));
+    }
+}
+
+TEST(PredicatesTest, SegmentCrossingsNearMiss) {
+    const Segment segment{Point{0, 0}, Point{4, 0}};
+    const Segment near_miss{Point{4 + 5E-7, -1}, Point{4 + 5E-7, 1}};
+    const Segment touching{Point{4, -1}, Point{4, 1}};
+    const Line near_miss_line{Point{4 + 5E-7, -1}, Point{4 + 5E-7, 1}};
+    Point inter_point;
+
+    ASSERT_FALSE(segment.cross_line(near_miss, inter_point));
+    ASSERT_TRUE(segment.cross_line(touching, inter_point));
+    ASSERT_FALSE(segment.cross_line(near_miss_line, inter_point));
+}
+
+TEST(PolygonTest, IsSegmentInsideTouchingVertex) {
+    Polygon poly;
+    poly.push_back(Point{0, 0});
+    poly.push_back(Point{0, 4});
+    poly.push_back(Point{2, 2});
+    poly.push_back(Point{4, 4});
+    poly.push_back(Point{4, 0});
+
+    // The segment goes through the reflex vertex without leaving the polygon
+    ASSERT_TRUE(poly.is_segment_inside(Segment{Point{0, 2}, Point{4, 2}}, 0, 3));
+    ASSERT_FALSE(poly.is_segment_inside(Segment{Point{0, 3}, Point{4, 3}}, 0, 3));
+}
+
+TEST(PolygonTest, IsPointInsideVertexOnRay) {
+    Polygon poly;
+    poly.push_back(Point{0, 1});
+    poly.push_back(Point{1, 0});
+    poly.push_back(Point{0, -1});
+    poly.push_back(Point{-1, 0});
+
+    ASSERT_TRUE(poly.is_point_inside(Point{0, 0}));
+    ASSERT_TRUE(poly.is_point_inside(Point{0, 0.5}));
+    ASSERT_TRUE(poly.is_point_inside(Point{0.5, 0.5}));
+    ASSERT_FALSE(poly.is_point_inside(Point{0, -2}));
+    ASSERT_FALSE(poly.is_point_inside(Point{1, -1}));
+}
+
+/* Kernel Tests */
+TEST(KernelTest, MatchesScalar) {
+    const size_t n_vertices{1001};
+    Points points;
+    for (size_t i = 0; i < n_vertices; ++i) {
+        double angle{2 * M_PI * static_cast<double>(i) / static_cast<double>(n_vertices)};
+        double radius{(i % 3 == 0) ? 10.0 : 7.0};
+        points.push_back(Point{radius * cos(angle), radius * sin(angle)});
+    }
+    const poly_private::VertexArray array{points};
+
+    ASSERT_NEAR(poly_private::signed_square(array), poly_private::signed_square_scalar(array), POLY_SPLIT_EPS);
+    ASSERT_NEAR(poly_private::clockwise_sum(array), poly_private::clockwise_sum_scalar(array), POLY_SPLIT_EPS);
+
+    for (double x = -12; x <= 12; x += 1.5) {
+        for (double y = -12; y <= 12; y += 1.5) {
+            const Point point{x, y};
+            ASSERT_EQ(poly_private::min_distance(array, point), poly_private::min_distance_scalar(array, point));
+            ASSERT_EQ(poly_private::crossing_count(array, point), poly_private::crossing_count_scalar(array, point));
+        }
+    }
+}
+
+TEST(PolygonTest, SplitStatistics) {
+    const size_t n_vertices{64};
+    Polygon original_poly;
+    for (size_t i = 0; i < n_vertices; ++i) {
+        double angle{2 * M_PI * static_cast<double>(i) / static_cast<double>(n_vertices)};
+        original_poly.push_back(Point{10 * cos(angle), 10 * sin(angle)});
+    }
+    Polygon first_poly;
+    Polygon second_poly;
+    Segment cut_line;
+    Polygon::SplitStatistics statistics;
+    const double expected_area{original_poly.count_square() / 4};
+
+    ASSERT_NO_THROW(original_poly.split(expected_area, first_poly, second_poly, cut_line, &statistics));
+    ASSERT_NEAR(std::min(first_poly.count_square(), second_poly.count_square()), expected_area, POLY_SPLIT_EPS);
+    ASSERT_EQ(statistics.evaluated_pairs + statistics.pruned_pairs, n_vertices * (n_vertices - 1) / 2);
+    ASSERT_GT(statistics.pruned_pairs, 0);
+}
+
+TEST(PolygonTest, SplitParallel) {
+    const size_t n_vertices{48};
+    Polygon original_poly;
+    for (size_t i = 0; i < n_vertices; ++i) {
+        double angle{2 * M_PI * static_cast<double>(i) / static_cast<double>(n_vertices)};
+        double radius{(i % 2 == 0) ? 10.0 : 6.0};
+        original_poly.push_back(Point{radius * cos(angle), radius * sin(angle)});
+    }
+    Polygon first_poly;
+    Polygon second_poly;
+    Segment cut_line;
+    Polygon first_poly_parallel;
+    Polygon second_poly_parallel;
+    Segment cut_line_parallel;
+    const double expected_area{original_poly.count_square() / 3};
+
+    ASSERT_NO_THROW(original_poly.split(expected_area, first_poly, second_poly, cut_line));
+    ASSERT_NO_THROW(original_poly.split_parallel(expected_area, first_poly_parallel, second_poly_parallel, cut_line_parallel, 4));
+    ASSERT_EQ(cut_line.get_start().x, cut_line_parallel.get_start().x);
+    ASSERT_EQ(cut_line.get_start().y, cut_line_parallel.get_start().y);
+    ASSERT_EQ(cut_line.get_end().x, cut_line_parallel.get_end().x);
+    ASSERT_EQ(cut_line.get_end().y, cut_line_parallel.get_end().y);
+    ASSERT_EQ(first_poly.size(), first_poly_parallel.size());
+    ASSERT_EQ(second_poly.size(), second_poly_parallel.size());
+}
+
+/* Partitioner Tests */
+static Points get_partition_area() {
+    return Points{{-20, 10}, {-10, 30}, {7.5, 30}, {15, 10}, {22.5, 20}, {30, -10}, {-25, -10}, {-40, -5}, {-30, 20}};
+}
+
+TEST(PartitionerTest, Sequential) {
+    const Polygon area{get_partition_area()};
+    const unsigned int number_of_polygons{5};
+    const double expected_area{area.count_square() / number_of_polygons};
+
+    std::vector<Polygon> polygons{SequentialPartitioner{}.partition(area, number_of_polygons)};
+
+    ASSERT_EQ(polygons.size(), number_of_polygons);
+    for (const Polygon &polygon : polygons) {
+        ASSERT_NEAR(polygon.count_square(), expected_area, 1E-3);
+    }
+}
+
+TEST(PartitionerTest, Bisection) {
+    const Polygon area{get_partition_area()};
+
+    for (unsigned int number_of_polygons = 1; number_of_polygons <= 7; ++number_of_polygons) {
+        const double expected_area{area.count_square() / number_of_polygons};
+
+        std::vector<Polygon> polygons{BisectionPartitioner{}.partition(area, number_of_polygons)};
+
+        ASSERT_EQ(polygons.size(), number_of_polygons);
+        for (const Polygon &polygon : polygons) {
+            ASSERT_NEAR(polygon.count_square(), expected_area, 1E-3);
+        }
+    }
+}
+
+TEST(PartitionerTest, Strip) {
+    const Polygon area{get_partition_area()};
+
+    const Vector direction{1, 2};
+    for (unsigned int number_of_polygons = 1; number_of_polygons <= 7; ++number_of_polygons) {
+        const double expected_area{area.count_square() / number_of_polygons};
+
+        std::vector<Polygon> polygons{StripPartitioner{direction}.partition(area, number_of_polygons)};
+
+        ASSERT_EQ(polygons.size(), number_of_polygons);
+        double total_area{0};
+        for (const Polygon &polygon : polygons) {
+            ASSERT_NEAR(polygon.count_square(), expected_area, 1E-9);
+            ASSERT_TRUE(polygon.find_crossings().empty());
+            total_area += polygon.count_square();
+
+            if (number_of_polygons > 1) {
+                // Every strip begins with an edge along one of the cut lines
+                const Point first_edge{polygon[1] - polygon[0]};
+                ASSERT_NEAR(first_edge.x * direction.y - first_edge.y * direction.x, 0, 1E-9);
+            }
+        }
+        ASSERT_NEAR(total_area, area.count_square(), 1E-9);
+    }
+
+    // The default direction is the one of the first edge of the area
+    std::vector<Polygon> polygons{StripPartitioner{}.partition(area, 3)};
+    ASSERT_EQ(polygons.size(), 3);
+    for (const Polygon &polygon : polygons) {
+        ASSERT_NEAR(polygon.count_square(), area.count_square() / 3, 1E-9);
+    }
+
+    // Every line across a U crosses it along a single segment, but the
+    // lines along it cross both arms, so the U is not split along them
+    const Polygon u_shape{Points{{0, 0}, {10, 0}, {10, 10}, {7, 10}, {7, 3}, {3, 3}, {3, 10}, {0, 10}}};
+    const StripPartitioner across_u{Vector{0, 1}};
+    const StripPartitioner along_u{Vector{1, 0}};
+    for (unsigned int number_of_polygons = 2; number_of_polygons <= 4; ++number_of_polygons) {
+        polygons = across_u.partition(u_shape, number_of_polygons);
+        ASSERT_EQ(polygons.size(), number_of_polygons);
+        for (const Polygon &polygon : polygons) {
+            ASSERT_NEAR(polygon.count_square(), u_shape.count_square() / number_of_polygons, 1E-3);
+            ASSERT_TRUE(polygon.find_crossings().empty());
+        }
+        ASSERT_THROW(along_u.partition(u_shape, number_of_polygons), Polygon::CannotSplitException);
+    }
+
+    const StripPartitioner null_direction{Vector{0, 0}};
+    ASSERT_THROW(null_direction.partition(area, 2), Polygon::CannotSplitException);
+    const Polygon segment{Points{Point{0, 0}, Point{1, 1}}};
+    ASSERT_THROW(StripPartitioner{}.partition(segment, 2), Polygon::CannotSplitException);
+}